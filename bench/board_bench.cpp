@@ -0,0 +1,283 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "alloc_stats.h"
+#include "board_probe.h"
+
+using namespace game;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto kMinSampleTime = std::chrono::milliseconds(100);
+constexpr size_t kMaxIterations = size_t{1} << 26;
+constexpr uint32_t kFillSeed = 2024;
+constexpr int kFillLevels[]{0, 6, 12, 18};
+// Only these may allocate with --check-allocs; everything a running game
+// calls every frame must not.
+constexpr const char* kAllocatingBenchmarks[]{"SaveToJson", "LoadFromJson"};
+
+bool check_allocs = false;
+int allocating_benchmarks = 0;
+
+struct Result {
+    double ns_per_op;
+    double allocs_per_op;
+};
+
+template <typename T>
+inline void DoNotOptimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs fn until the sample is long enough to be stable and returns the cost
+// of one call. ops_per_call divides the result when fn performs several
+// operations that bring the board back to its starting state.
+template <typename Fn>
+Result Measure(Fn&& fn, size_t ops_per_call = 1) {
+    for (int i = 0; i < 16; ++i) {
+        fn();
+    }
+    size_t iterations = 16;
+    while (true) {
+        auto allocs_before = alloc_stats::Current().allocations;
+        auto start = Clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            fn();
+        }
+        auto elapsed = Clock::now() - start;
+        auto allocs = alloc_stats::Current().allocations - allocs_before;
+        if (elapsed >= kMinSampleTime || iterations >= kMaxIterations) {
+            double ops = static_cast<double>(iterations * ops_per_call);
+            double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+            return Result{ns / ops, static_cast<double>(allocs) / ops};
+        }
+        iterations *= 2;
+    }
+}
+
+// Cost of fn minus the cost of the state restore it has to perform first.
+template <typename Fn, typename Restore>
+Result MeasureNet(Fn&& fn, Restore&& restore) {
+    Result gross = Measure([&] { restore(); fn(); });
+    Result baseline = Measure(restore);
+    double ns = gross.ns_per_op - baseline.ns_per_op;
+    double allocs = gross.allocs_per_op - baseline.allocs_per_op;
+    return Result{ns > 0 ? ns : 0, allocs > 0 ? allocs : 0};
+}
+
+struct Fixture {
+    Board<> board{};
+    BoardProbe<> probe{board};
+    BoardProbe<>::Snapshot snapshot;
+
+    explicit Fixture(int fill_rows) {
+        this->probe.FillRows(fill_rows, kFillSeed);
+        this->probe.SetActualPiece(Shape::kPyramid, 0, this->board.GetBoardWidth() / 2 - 1);
+        this->snapshot = this->probe.Save();
+    }
+
+    void Restore() {
+        this->probe.Restore(this->snapshot);
+    }
+};
+
+void Report(const char* name, int fill_percent, Result result) {
+    std::printf("%-28s %5d%% %12.1f %12.2f\n", name, fill_percent,
+                result.ns_per_op, result.allocs_per_op);
+    bool may_allocate = std::any_of(std::begin(kAllocatingBenchmarks), std::end(kAllocatingBenchmarks),
+                                    [name](const char* allowed) { return std::strcmp(name, allowed) == 0; });
+    if (check_allocs && !may_allocate && result.allocs_per_op > 0) {
+        std::printf("  ^ allocates\n");
+        ++allocating_benchmarks;
+    }
+}
+
+bool Selected(const char* filter, const char* name) {
+    return filter == nullptr || std::strstr(name, filter) != nullptr;
+}
+
+void RunFillLevel(const char* filter, int fill_rows) {
+    const int fill_percent = fill_rows * 100 / Board<>{}.GetBoardHeight();
+    if (Selected(filter, "CheckPieceValid")) {
+        Fixture f{fill_rows};
+        Report("CheckPieceValid", fill_percent, Measure([&] {
+            DoNotOptimize(f.probe.CheckPieceValid());
+        }));
+    }
+    if (Selected(filter, "MovePiece")) {
+        Fixture f{fill_rows};
+        Report("MovePiece", fill_percent, Measure([&] {
+            f.probe.MovePiece(MoveType::kLeft);
+            f.probe.MovePiece(MoveType::kRight);
+        }, 2));
+    }
+    if (Selected(filter, "RotatePiece")) {
+        Fixture f{fill_rows};
+        Report("RotatePiece", fill_percent, Measure([&] {
+            for (int i = 0; i < rotations_count; ++i) {
+                f.probe.RotatePiece();
+            }
+        }, rotations_count));
+    }
+    if (Selected(filter, "RotateKick")) {
+        // A flat I resting on the stack against the left wall: turning it
+        // upright in place hits the stack, so the kick tests are walked.
+        Fixture f{fill_rows};
+        f.probe.SetActualPiece(Shape::kBar, 0, 0);
+        f.probe.SetActualPiece(Shape::kBar, f.probe.GetShadowPieceRowPosition(), 0);
+        f.snapshot = f.probe.Save();
+        Report("RotateKick", fill_percent, MeasureNet([&] {
+            f.probe.RotatePiece(Turn::kCounterClockwise);
+        }, [&] { f.Restore(); }));
+    }
+    if (Selected(filter, "HardDrop")) {
+        Fixture f{fill_rows};
+        Report("HardDrop", fill_percent, MeasureNet([&] {
+            f.probe.HardDrop();
+        }, [&] { f.Restore(); }));
+    }
+    if (Selected(filter, "GetShadowPieceRowPosition")) {
+        Fixture f{fill_rows};
+        Report("GetShadowPieceRowPosition", fill_percent, Measure([&] {
+            DoNotOptimize(f.probe.GetShadowPieceRowPosition());
+        }));
+    }
+    if (Selected(filter, "FindLinesToClear")) {
+        Fixture f{fill_rows};
+        int height = f.board.GetBoardHeight();
+        Report("FindLinesToClear", fill_percent, Measure([&] {
+            f.probe.TouchRows(height - 4, height);
+            DoNotOptimize(f.probe.FindLinesToClear());
+        }));
+    }
+    if (Selected(filter, "ClearLines")) {
+        Fixture f{fill_rows};
+        int bottom = f.board.GetBoardHeight() - 1;
+        f.probe.FillLine(bottom, 1);
+        f.probe.FillLine(bottom - 2, 1);
+        f.snapshot = f.probe.Save();
+        Report("ClearLines", fill_percent, MeasureNet([&] {
+            f.probe.ClearLines();
+        }, [&] {
+            f.Restore();
+            f.probe.TouchRows(bottom - 3, bottom + 1);
+            DoNotOptimize(f.probe.FindLinesToClear());
+        }));
+    }
+    if (Selected(filter, "MergePieceIntoBoard")) {
+        Fixture f{fill_rows};
+        int row = f.probe.GetShadowPieceRowPosition();
+        f.probe.SetActualPiece(Shape::kPyramid, row, f.board.GetBoardWidth() / 2 - 1);
+        f.snapshot = f.probe.Save();
+        Report("MergePieceIntoBoard", fill_percent, MeasureNet([&] {
+            f.probe.MergePieceIntoBoard();
+        }, [&] { f.Restore(); }));
+    }
+    if (Selected(filter, "UpdateGameplayIdle")) {
+        Fixture f{fill_rows};
+        f.probe.HoldGravity();
+        Report("UpdateGameplayIdle", fill_percent, Measure([&] {
+            f.probe.UpdateGameplay(MoveType::kNone);
+        }));
+    }
+    if (Selected(filter, "MakePiece")) {
+        Fixture f{fill_rows};
+        Report("MakePiece", fill_percent, Measure([&] {
+            f.probe.MakePiece();
+        }));
+    }
+    if (Selected(filter, "BoardClean")) {
+        Fixture f{fill_rows};
+        Report("BoardClean", fill_percent, Measure([&] {
+            f.probe.BoardClean();
+            DoNotOptimize(f.board);
+        }));
+    }
+    if (Selected(filter, "GameTick")) {
+        // Whole games at 60 ticks per second with a hard drop every other
+        // tick: spawns, locks, line checks, top-outs and resets.
+        Fixture f{fill_rows};
+        FrameTime tick{Clock::now(), 0};
+        Report("GameTick", fill_percent, Measure([&] {
+            if (f.board.GetActualGamePhase() == GameState::kGameStartPhase) {
+                f.board.PlayGame();
+            }
+            tick = FrameTime{tick.now + std::chrono::microseconds(16667), tick.index + 1};
+            MoveType move = tick.index % 2 == 0 ? MoveType::kDrop : MoveType::kLeft;
+            DoNotOptimize(f.board.UpdateGame(move, tick));
+        }));
+    }
+    if (Selected(filter, "GameTickNes")) {
+        // The same games counted in NES frames, with entry delays and line
+        // clear animations.
+        Fixture f{fill_rows};
+        f.board.SetTimingModel(TimingModel::kNesFrames);
+        FrameTime tick{Clock::now(), 0};
+        Report("GameTickNes", fill_percent, Measure([&] {
+            if (f.board.GetActualGamePhase() == GameState::kGameStartPhase) {
+                f.board.PlayGame();
+            }
+            tick = FrameTime{tick.now + std::chrono::microseconds(16667), tick.index + 1};
+            MoveType move = tick.index % 2 == 0 ? MoveType::kDrop : MoveType::kLeft;
+            DoNotOptimize(f.board.UpdateGame(move, tick));
+        }));
+    }
+    if (Selected(filter, "BoardCopy")) {
+        Fixture f{fill_rows};
+        Report("BoardCopy", fill_percent, Measure([&] {
+            Board<> copy{f.board};
+            DoNotOptimize(copy);
+        }));
+    }
+    if (Selected(filter, "BoardAssign")) {
+        Fixture f{fill_rows};
+        Board<> target{};
+        Report("BoardAssign", fill_percent, Measure([&] {
+            target = f.board;
+            DoNotOptimize(target);
+        }));
+    }
+    if (Selected(filter, "SaveToJson")) {
+        Fixture f{fill_rows};
+        Report("SaveToJson", fill_percent, Measure([&] {
+            json doc = f.board.SaveToJson();
+            DoNotOptimize(doc);
+        }));
+    }
+    if (Selected(filter, "LoadFromJson")) {
+        Fixture f{fill_rows};
+        json doc = f.board.SaveToJson();
+        Board<> target{};
+        Report("LoadFromJson", fill_percent, Measure([&] {
+            DoNotOptimize(target.LoadFromJson(doc));
+        }));
+    }
+}
+
+}
+
+// Usage: board_bench [--check-allocs] [name-filter]
+// --check-allocs fails when a gameplay benchmark allocates.
+int main(int argc, char* argv[]) {
+    const char* filter = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--check-allocs") == 0) {
+            check_allocs = true;
+        } else {
+            filter = argv[i];
+        }
+    }
+    std::printf("%-28s %6s %12s %12s\n", "benchmark", "fill", "ns/op", "allocs/op");
+    for (int fill_rows : kFillLevels) {
+        RunFillLevel(filter, fill_rows);
+    }
+    if (allocating_benchmarks > 0) {
+        std::printf("%d gameplay benchmarks allocate\n", allocating_benchmarks);
+        return 1;
+    }
+    return 0;
+}
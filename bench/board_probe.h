@@ -0,0 +1,127 @@
+#pragma once
+
+#include "board.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace game {
+
+// Exposes Board internals to benchmarks and tools without widening
+// the public IBoard interface.
+template <std::uint8_t W = 10, std::uint8_t H = 22>
+class BoardProbe {
+public:
+    using BoardType = Board<W, H>;
+
+    // A Board copy is a full snapshot: all state lives inline, nothing on the heap.
+    using Snapshot = BoardType;
+
+    explicit BoardProbe(BoardType& board) : board_(board) {}
+
+    // Fills the bottom rows with random cells, leaving one hole per row
+    // so no line is complete.
+    void FillRows(int rows, uint32_t seed) {
+        std::mt19937 gen{seed};
+        std::uniform_int_distribution<int> col_dist(0, W - 1);
+        std::uniform_int_distribution<int> value_dist(1, static_cast<int>(Shape::kNumOfShapes));
+        std::bernoulli_distribution occupied(0.7);
+        for (int i = 0; i < rows; ++i) {
+            int row = H - 1 - i;
+            int hole = col_dist(gen);
+            for (int col = 0; col < W; ++col) {
+                uint8_t value = 0;
+                if (col != hole && occupied(gen)) {
+                    value = static_cast<uint8_t>(value_dist(gen));
+                }
+                this->board_.SetValue(row, col, value);
+            }
+        }
+    }
+
+    void FillLine(int row, uint8_t value) {
+        for (int col = 0; col < W; ++col) {
+            this->board_.SetValue(row, col, value);
+        }
+    }
+
+    void SetCell(int row, int col, uint8_t value) {
+        this->board_.SetValue(row, col, value);
+    }
+
+    uint8_t GetCell(int row, int col) const {
+        return this->board_.GetValue(row, col);
+    }
+
+    void SetActualPiece(Shape shape, int offset_row, int offset_col) {
+        this->board_.actual_piece_ = typename BoardType::PieceState{Piece{shape}, offset_row, offset_col};
+    }
+
+    Snapshot Save() const {
+        return this->board_;
+    }
+
+    void Restore(const Snapshot& snapshot) {
+        this->board_ = snapshot;
+    }
+
+    // Marks rows as written by a lock so FindLinesToClear checks them.
+    void TouchRows(int begin, int end) {
+        this->board_.locked_row_begin_ = begin;
+        this->board_.locked_row_end_ = end;
+    }
+
+    void UpdateGameplay(MoveType input) {
+        this->board_.UpdateGameplay(input);
+    }
+
+    void HoldGravity() {
+        this->board_.next_drop_time_ = std::numeric_limits<float>::max();
+    }
+
+    bool CheckPieceValid() const {
+        return this->board_.CheckPieceValid(this->board_.actual_piece_);
+    }
+
+    void MovePiece(MoveType move) {
+        this->board_.MovePiece(move);
+    }
+
+    void RotatePiece(Turn turn = Turn::kClockwise) {
+        this->board_.RotatePiece(turn);
+    }
+
+    void HardDrop() {
+        this->board_.HardDrop();
+    }
+
+    int GetShadowPieceRowPosition() {
+        return this->board_.GetShadowPieceRowPosition();
+    }
+
+    int FindLinesToClear() {
+        return this->board_.FindLinesToClear();
+    }
+
+    void ClearLines() {
+        this->board_.ClearLines();
+    }
+
+    void MergePieceIntoBoard() {
+        this->board_.MergePieceIntoBoard();
+    }
+
+    void MakePiece() {
+        this->board_.MakePiece(0, W / 2 - 1);
+    }
+
+    void BoardClean() {
+        this->board_.BoardClean();
+    }
+
+private:
+    BoardType& board_;
+};
+
+}
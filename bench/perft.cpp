@@ -0,0 +1,489 @@
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "board_probe.h"
+
+using namespace game;
+
+namespace {
+
+constexpr int kMaxRows = 32;
+
+// Board occupancy, one bit per column. Colors are ignored, two boards are the
+// same state when the same cells are filled.
+using Cells = std::array<uint16_t, kMaxRows>;
+
+struct CellsHash {
+    size_t operator()(const Cells& cells) const {
+        uint64_t hash = 1469598103934665603ull;
+        for (auto row : cells) {
+            hash = (hash ^ row) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+using CellsSet = std::unordered_set<Cells, CellsHash>;
+
+enum class Mode {
+    kDrop,  // rotate clockwise and shift at the spawn row, then hard drop
+    kFull   // any sequence of shifts, rotations in all three turns and soft drops
+};
+
+struct Geometry {
+    int width;
+    int height;
+    int spawn_col;
+    uint16_t full_row;
+};
+
+struct PieceMasks {
+    Shape shape;
+    int dim;
+    std::array<std::array<uint16_t, 4>, rotations_count> rows;
+};
+
+struct Position {
+    int rotation;
+    int row;
+    int col;
+};
+
+struct Options {
+    int depth = 3;
+    std::string pieces = "TIOLJSZ";
+    int fill_rows = 0;
+    uint32_t seed = 1;
+    Mode mode = Mode::kDrop;
+    bool verify = false;
+};
+
+bool ParseShape(char letter, Shape& shape) {
+    switch (letter) {
+        case 'O': shape = Shape::kSquare; return true;
+        case 'I': shape = Shape::kBar; return true;
+        case 'T': shape = Shape::kPyramid; return true;
+        case 'S': shape = Shape::kSShape; return true;
+        case 'Z': shape = Shape::kZShape; return true;
+        case 'L': shape = Shape::kLShape; return true;
+        case 'J': shape = Shape::kJShape; return true;
+        default: return false;
+    }
+}
+
+// Bitboard move generator, independent of the Board movement code it is
+// checked against. Only the kick tables are shared.
+class MoveGenerator {
+public:
+    explicit MoveGenerator(const Geometry& geometry) : geometry_(geometry) {
+        for (int i = 0; i < static_cast<int>(Shape::kNumOfShapes); ++i) {
+            Piece piece{static_cast<Shape>(i)};
+            auto& masks = this->masks_[i];
+            masks.shape = piece.GetShape();
+            masks.dim = piece.GetDim();
+            for (int rotation = 0; rotation < rotations_count; ++rotation) {
+                auto shape = piece.GetPiece();
+                for (int row = 0; row < masks.dim; ++row) {
+                    uint16_t mask = 0;
+                    for (int col = 0; col < masks.dim; ++col) {
+                        if (*shape++) {
+                            mask |= 1u << col;
+                        }
+                    }
+                    masks.rows[rotation][row] = mask;
+                }
+                piece = piece.FastRotation();
+            }
+        }
+    }
+
+    void Generate(const Cells& cells, Shape shape, Mode mode, CellsSet& out) const {
+        const auto& masks = this->masks_[static_cast<int>(shape)];
+        if (!this->Fits(cells, masks, 0, 0, this->geometry_.spawn_col)) {
+            return;
+        }
+        if (mode == Mode::kDrop) {
+            this->GenerateDrops(cells, masks, out);
+        }
+        else {
+            this->GenerateAll(cells, masks, out);
+        }
+    }
+
+    bool Fits(const Cells& cells, const PieceMasks& masks, int rotation, int row, int col) const {
+        for (int i = 0; i < masks.dim; ++i) {
+            uint16_t mask = masks.rows[rotation][i];
+            if (!mask) {
+                continue;
+            }
+            int board_row = row + i;
+            if (board_row < 0 || board_row >= this->geometry_.height) return false;
+            uint32_t shifted;
+            if (col >= 0) {
+                shifted = static_cast<uint32_t>(mask) << col;
+            }
+            else {
+                if (mask & ((1u << -col) - 1)) return false;
+                shifted = mask >> -col;
+            }
+            if (shifted & ~static_cast<uint32_t>(this->geometry_.full_row)) return false;
+            if (shifted & cells[board_row]) return false;
+        }
+        return true;
+    }
+
+    // Merges the piece and clears full lines. A piece locked into the top row
+    // ends the game, so such a board is kept as it is.
+    Cells Lock(const Cells& cells, const PieceMasks& masks, int rotation, int row, int col) const {
+        Cells merged = cells;
+        for (int i = 0; i < masks.dim; ++i) {
+            uint16_t mask = masks.rows[rotation][i];
+            if (mask) {
+                merged[row + i] |= col >= 0 ? mask << col : mask >> -col;
+            }
+        }
+        if (merged[0]) {
+            return merged;
+        }
+        Cells cleared{};
+        int dest = this->geometry_.height - 1;
+        for (int src = this->geometry_.height - 1; src >= 0; --src) {
+            if (merged[src] != this->geometry_.full_row) {
+                cleared[dest--] = merged[src];
+            }
+        }
+        return cleared;
+    }
+
+    bool IsTerminal(const Cells& cells) const {
+        return cells[0] != 0;
+    }
+
+    // Moves position to the first kick test that fits, false if none does.
+    bool Rotate(const Cells& cells, const PieceMasks& masks, Turn turn, Position& position) const {
+        int rotation = (position.rotation + GetQuarterTurns(turn)) % rotations_count;
+        for (const Kick& kick : GetKicks(Piece{masks.shape, static_cast<uint8_t>(position.rotation)}, turn)) {
+            if (this->Fits(cells, masks, rotation, position.row + kick.row, position.col + kick.col)) {
+                position = Position{rotation, position.row + kick.row, position.col + kick.col};
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    Geometry geometry_;
+    std::array<PieceMasks, static_cast<int>(Shape::kNumOfShapes)> masks_{};
+
+    void GenerateDrops(const Cells& cells, const PieceMasks& masks, CellsSet& out) const {
+        Position start{0, 0, this->geometry_.spawn_col};
+        for (int turns = 0; turns < rotations_count; ++turns) {
+            if (turns > 0 && !this->Rotate(cells, masks, Turn::kClockwise, start)) {
+                break;
+            }
+            const int rotation = start.rotation;
+            for (int direction : {-1, 1}) {
+                for (int col = start.col; this->Fits(cells, masks, rotation, start.row, col); col += direction) {
+                    int row = start.row;
+                    while (this->Fits(cells, masks, rotation, row + 1, col)) {
+                        ++row;
+                    }
+                    out.insert(this->Lock(cells, masks, rotation, row, col));
+                }
+            }
+        }
+    }
+
+    void GenerateAll(const Cells& cells, const PieceMasks& masks, CellsSet& out) const {
+        const int width = this->geometry_.width;
+        const int height = this->geometry_.height;
+        // Kicks can leave the box's empty rows above the board and columns
+        // left of it.
+        const int row_base = 4;
+        const int col_base = 4;
+        auto index = [&](int rotation, int row, int col) {
+            return (rotation * (height + row_base) + row + row_base) * (width + col_base) + col + col_base;
+        };
+        std::vector<bool> visited(rotations_count * (height + row_base) * (width + col_base), false);
+        std::vector<Position> stack{{0, 0, this->geometry_.spawn_col}};
+        visited[index(0, 0, this->geometry_.spawn_col)] = true;
+        while (!stack.empty()) {
+            auto position = stack.back();
+            stack.pop_back();
+            auto [rotation, row, col] = position;
+            if (!this->Fits(cells, masks, rotation, row + 1, col)) {
+                out.insert(this->Lock(cells, masks, rotation, row, col));
+            }
+            Position next[]{
+                    {rotation, row, col - 1},
+                    {rotation, row, col + 1},
+                    {rotation, row + 1, col},
+                    position,
+                    position,
+                    position
+            };
+            bool fits[]{
+                    this->Fits(cells, masks, rotation, row, col - 1),
+                    this->Fits(cells, masks, rotation, row, col + 1),
+                    this->Fits(cells, masks, rotation, row + 1, col),
+                    this->Rotate(cells, masks, Turn::kClockwise, next[3]),
+                    this->Rotate(cells, masks, Turn::kHalf, next[4]),
+                    this->Rotate(cells, masks, Turn::kCounterClockwise, next[5])
+            };
+            for (size_t n = 0; n < std::size(next); ++n) {
+                const auto& candidate = next[n];
+                if (!fits[n] || candidate.col < -col_base || candidate.row < -row_base) {
+                    continue;
+                }
+                auto i = index(candidate.rotation, candidate.row, candidate.col);
+                if (!visited[i]) {
+                    visited[i] = true;
+                    stack.push_back(candidate);
+                }
+            }
+        }
+    }
+};
+
+// Reference placements found by pressing keys on real Board copies through
+// Board::MovePiece. Slow, used only to check the generator.
+class KeypressOracle {
+public:
+    explicit KeypressOracle(const Geometry& geometry) : geometry_(geometry) {}
+
+    void Generate(const Cells& cells, Shape shape, Mode mode, CellsSet& out) {
+        this->Load(cells);
+        Board<> start{this->base_};
+        BoardProbe{start}.SetActualPiece(shape, 0, this->geometry_.spawn_col);
+        if (!BoardProbe{start}.CheckPieceValid()) {
+            return;
+        }
+        if (mode == Mode::kDrop) {
+            this->GenerateDrops(start, out);
+        }
+        else {
+            this->GenerateAll(start, out);
+        }
+    }
+
+private:
+    Geometry geometry_;
+    Board<> base_{};
+
+    void Load(const Cells& cells) {
+        BoardProbe probe{this->base_};
+        for (int row = 0; row < this->geometry_.height; ++row) {
+            for (int col = 0; col < this->geometry_.width; ++col) {
+                probe.SetCell(row, col, (cells[row] >> col) & 1u);
+            }
+        }
+    }
+
+    Cells Read(Board<>& board) const {
+        BoardProbe probe{board};
+        Cells cells{};
+        for (int row = 0; row < this->geometry_.height; ++row) {
+            for (int col = 0; col < this->geometry_.width; ++col) {
+                if (probe.GetCell(row, col)) {
+                    cells[row] |= 1u << col;
+                }
+            }
+        }
+        return cells;
+    }
+
+    Cells Settle(Board<>& board) const {
+        BoardProbe probe{board};
+        if (this->Read(board)[0]) {
+            return this->Read(board);
+        }
+        if (probe.FindLinesToClear() > 0) {
+            probe.ClearLines();
+        }
+        return this->Read(board);
+    }
+
+    void GenerateDrops(const Board<>& start, CellsSet& out) {
+        for (int rotation = 0; rotation < rotations_count; ++rotation) {
+            for (int shift = -this->geometry_.width; shift <= this->geometry_.width; ++shift) {
+                Board<> board{start};
+                BoardProbe probe{board};
+                for (int i = 0; i < rotation; ++i) {
+                    probe.MovePiece(MoveType::kUp);
+                }
+                for (int i = 0; i < std::abs(shift); ++i) {
+                    probe.MovePiece(shift < 0 ? MoveType::kLeft : MoveType::kRight);
+                }
+                probe.MovePiece(MoveType::kDrop);
+                out.insert(this->Settle(board));
+            }
+        }
+    }
+
+    void GenerateAll(const Board<>& start, CellsSet& out) {
+        // A blocked move leaves the piece untouched, so its key is already visited.
+        auto key = [&](const Board<>& board) {
+            int rotation = board.GetPieceRotation(PieceType::kActualPiece);
+            int row = board.GetPieceRowPosition(PieceType::kActualPiece);
+            int col = board.GetPieceColumnPosition(PieceType::kActualPiece);
+            return (rotation * 64 + row + 8) * 64 + col + 8;
+        };
+        std::unordered_set<int> visited{key(start)};
+        std::vector<Board<>> stack{start};
+        const MoveType moves[]{MoveType::kLeft, MoveType::kRight, MoveType::kUp, MoveType::kRotateCcw,
+                               MoveType::kRotate180, MoveType::kDown};
+        while (!stack.empty()) {
+            Board<> node = stack.back();
+            stack.pop_back();
+            for (auto move : moves) {
+                Board<> next = node;
+                BoardProbe probe{next};
+                int row = next.GetPieceRowPosition(PieceType::kActualPiece);
+                probe.MovePiece(move);
+                if (move == MoveType::kDown &&
+                    next.GetPieceRowPosition(PieceType::kActualPiece) != row + 1) {
+                    out.insert(this->Settle(next));
+                    continue;
+                }
+                if (visited.insert(key(next)).second) {
+                    stack.push_back(next);
+                }
+            }
+        }
+    }
+};
+
+Cells StartingCells(const Options& options, const Geometry& geometry) {
+    Board<> board{};
+    BoardProbe probe{board};
+    probe.FillRows(options.fill_rows, options.seed);
+    Cells cells{};
+    for (int row = 0; row < geometry.height; ++row) {
+        for (int col = 0; col < geometry.width; ++col) {
+            if (probe.GetCell(row, col)) {
+                cells[row] |= 1u << col;
+            }
+        }
+    }
+    return cells;
+}
+
+void PrintUsage(const char* name) {
+    std::fprintf(stderr,
+                 "Usage: %s [--depth N] [--pieces TIOLJSZ] [--fill ROWS] [--seed S]\n"
+                 "          [--mode drop|full] [--verify]\n", name);
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--depth" && has_value) {
+            options.depth = std::atoi(argv[++i]);
+        }
+        else if (arg == "--pieces" && has_value) {
+            options.pieces = argv[++i];
+        }
+        else if (arg == "--fill" && has_value) {
+            options.fill_rows = std::atoi(argv[++i]);
+        }
+        else if (arg == "--seed" && has_value) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--mode" && has_value) {
+            std::string mode = argv[++i];
+            if (mode == "drop") options.mode = Mode::kDrop;
+            else if (mode == "full") options.mode = Mode::kFull;
+            else return false;
+        }
+        else if (arg == "--verify") {
+            options.verify = true;
+        }
+        else {
+            return false;
+        }
+    }
+    Shape shape{};
+    for (char letter : options.pieces) {
+        if (!ParseShape(letter, shape)) {
+            return false;
+        }
+    }
+    return options.depth > 0 && !options.pieces.empty();
+}
+
+}
+
+// Counts the distinct boards reachable after placing 1..depth pieces of the
+// given sequence (repeated when shorter than depth). With --verify every
+// generated placement set is compared with the keypress oracle.
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    Board<> reference{};
+    Geometry geometry{reference.GetBoardWidth(), reference.GetBoardHeight(),
+                      reference.GetBoardWidth() / 2 - 1,
+                      static_cast<uint16_t>((1u << reference.GetBoardWidth()) - 1)};
+    MoveGenerator generator{geometry};
+    KeypressOracle oracle{geometry};
+
+    std::vector<Cells> frontier{StartingCells(options, geometry)};
+    std::printf("%-6s %5s %14s %14s %12s %14s %14s\n", "depth", "piece", "placements", "states", "ms",
+                "placements/s", "states/s");
+    for (int depth = 1; depth <= options.depth; ++depth) {
+        char letter = options.pieces[(depth - 1) % options.pieces.size()];
+        Shape shape{};
+        if (!ParseShape(letter, shape)) {
+            PrintUsage(argv[0]);
+            return 2;
+        }
+
+        CellsSet states;
+        CellsSet placements;
+        size_t placement_count = 0;
+        // Generation alone, and with merging into the distinct states.
+        double generate_ms = 0;
+        double total_ms = 0;
+        for (const auto& cells : frontier) {
+            if (generator.IsTerminal(cells)) {
+                continue;
+            }
+            placements.clear();
+            auto start = std::chrono::steady_clock::now();
+            generator.Generate(cells, shape, options.mode, placements);
+            auto generated = std::chrono::steady_clock::now();
+            states.insert(placements.begin(), placements.end());
+            auto merged = std::chrono::steady_clock::now();
+            generate_ms += std::chrono::duration<double, std::milli>(generated - start).count();
+            total_ms += std::chrono::duration<double, std::milli>(merged - start).count();
+            placement_count += placements.size();
+            if (options.verify) {
+                CellsSet expected;
+                oracle.Generate(cells, shape, options.mode, expected);
+                if (expected != placements) {
+                    std::fprintf(stderr, "Mismatch at depth %d (%c): generator %zu, oracle %zu placements\n",
+                                 depth, letter, placements.size(), expected.size());
+                    return 1;
+                }
+            }
+        }
+
+        double placements_per_second = generate_ms > 0 ? placement_count / (generate_ms / 1000.0) : 0;
+        double states_per_second = total_ms > 0 ? states.size() / (total_ms / 1000.0) : 0;
+        std::printf("%-6d %5c %14zu %14zu %12.2f %14.0f %14.0f\n", depth, letter, placement_count,
+                    states.size(), total_ms, placements_per_second, states_per_second);
+        frontier.assign(states.begin(), states.end());
+    }
+    if (options.verify) {
+        std::printf("verify: generator matches Board::MovePiece keypress oracle\n");
+    }
+    return 0;
+}
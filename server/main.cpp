@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+#include <thread>
+#include "server.h"
+
+using namespace game::server;
+
+namespace {
+
+std::atomic<bool> stop{false};
+
+void HandleSignal(int) {
+    stop.store(true);
+}
+
+void PrintUsage(const char* name) {
+    std::fprintf(stderr,
+                 "Usage: %s [--address A] [--port P] [--players N] [--tick-rate HZ] [--threads N]\n", name);
+}
+
+bool ParseOptions(int argc, char* argv[], ServerConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--address" && has_value) {
+            config.address = argv[++i];
+        }
+        else if (arg == "--port" && has_value) {
+            config.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--players" && has_value) {
+            config.players_per_match = static_cast<size_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--tick-rate" && has_value) {
+            config.ticks_per_second = std::atoi(argv[++i]);
+        }
+        else if (arg == "--threads" && has_value) {
+            config.threads = static_cast<size_t>(std::atoi(argv[++i]));
+        }
+        else {
+            return false;
+        }
+    }
+    return config.players_per_match >= 1 && config.players_per_match <= 255 &&
+           config.ticks_per_second > 0 && config.threads > 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    ServerConfig config;
+    config.threads = std::max(1u, std::thread::hardware_concurrency());
+    if (!ParseOptions(argc, argv, config)) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+    std::signal(SIGINT, HandleSignal);
+    std::signal(SIGTERM, HandleSignal);
+
+    try {
+        Server server{config};
+        std::printf("Listening on %s:%u, %zu players per match, %d ticks/s, %zu threads\n",
+                    config.address, server.GetPort(), config.players_per_match,
+                    config.ticks_per_second, config.threads);
+        std::fflush(stdout);
+        server.Run(stop);
+    }
+    catch (const std::system_error& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
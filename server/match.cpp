@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <cassert>
+#include "match.h"
+#include "protocol.h"
+
+namespace game::server {
+
+Match::Match(uint32_t id, size_t player_count)
+    : id_(id), boards_(player_count), seats_(player_count), encoders_(player_count) {
+    for (auto& seat : this->seats_) {
+        seat.moves.reserve(kMaxMovesPerTick_);
+    }
+}
+
+uint32_t Match::GetId() const {
+    return this->id_;
+}
+
+size_t Match::GetPlayerCount() const {
+    return this->seats_.size();
+}
+
+bool Match::IsFull() const {
+    return std::all_of(this->seats_.begin(), this->seats_.end(), [](const Seat& seat) {
+        return seat.taken;
+    });
+}
+
+bool Match::IsRunning() const {
+    return this->running_ && !this->loser_;
+}
+
+bool Match::IsOver() const {
+    return this->loser_.has_value();
+}
+
+std::optional<size_t> Match::GetLoser() const {
+    return this->loser_;
+}
+
+const Board<>& Match::GetBoard(size_t player) const {
+    return this->boards_.at(player);
+}
+
+size_t Match::AddPlayer() {
+    auto seat = std::find_if(this->seats_.begin(), this->seats_.end(), [](const Seat& seat) {
+        return !seat.taken;
+    });
+    assert(seat != this->seats_.end());
+    seat->taken = true;
+    return static_cast<size_t>(seat - this->seats_.begin());
+}
+
+void Match::RemovePlayer(size_t player) {
+    this->seats_.at(player).taken = false;
+    if (this->running_ && !this->loser_) {
+        this->loser_ = player;
+    }
+}
+
+void Match::QueueInput(size_t player, MoveType move) {
+    auto& moves = this->seats_.at(player).moves;
+    if (moves.size() < kMaxMovesPerTick_) {
+        moves.push_back(move);
+    }
+}
+
+void Match::AddSpectator() {
+    ++this->spectator_count_;
+    for (auto& encoder : this->encoders_) {
+        encoder.RequestKeyframe();
+    }
+}
+
+void Match::RemoveSpectator() {
+    --this->spectator_count_;
+}
+
+std::span<const uint8_t> Match::GetSpectatorFeed() const {
+    return this->spectator_feed_;
+}
+
+void Match::Start(const FrameTime& frame_time) {
+    for (auto& board : this->boards_) {
+        board.StartGame();
+        board.UpdateGame(MoveType::kNone, frame_time);
+        board.PlayGame();
+    }
+    this->running_ = true;
+}
+
+void Match::Step(const FrameTime& frame_time) {
+    for (size_t i = 0; i < this->boards_.size() && !this->loser_; ++i) {
+        auto& board = this->boards_[i];
+        auto& moves = this->seats_[i].moves;
+        GameState phase = GameState::kGamePlayPhase;
+        for (auto move : moves) {
+            phase = board.UpdateGame(move, frame_time);
+            if (phase == GameState::kGameOverPhase) {
+                break;
+            }
+        }
+        moves.clear();
+        if (phase != GameState::kGameOverPhase) {
+            phase = board.UpdateGame(MoveType::kNone, frame_time);
+        }
+        if (phase == GameState::kGameOverPhase) {
+            this->loser_ = i;
+        }
+        this->SendGarbage(i);
+    }
+    ++this->tick_;
+    this->EncodeSpectatorFeed();
+}
+
+void Match::BeginTick() {
+    this->spectator_feed_.clear();
+}
+
+void Match::EncodeSpectatorFeed() {
+    if (this->spectator_count_ == 0) {
+        return;
+    }
+    for (size_t i = 0; i < this->boards_.size(); ++i) {
+        MessageWriter writer{this->spectator_feed_, MessageType::kSpectatorFrame};
+        writer.U8(static_cast<uint8_t>(i));
+        this->encoders_[i].Encode(this->boards_[i], this->tick_, this->spectator_feed_);
+    }
+}
+
+void Match::SendGarbage(size_t player) {
+    uint32_t lines = this->boards_[player].TakeOutgoingLines();
+    const size_t opponents = this->boards_.size() - 1;
+    if (lines == 0 || opponents == 0) {
+        return;
+    }
+    auto& seat = this->seats_[player];
+    size_t target = (player + 1 + seat.next_target) % this->boards_.size();
+    seat.next_target = (seat.next_target + 1) % opponents;
+    this->boards_[target].QueueGarbage(static_cast<uint8_t>(std::min<uint32_t>(lines, UINT8_MAX)));
+}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "board.h"
+#include "board_delta.h"
+
+namespace game::server {
+
+// A group of boards played against each other. The server thread adds players
+// and queues their moves between ticks; Step runs on a worker thread.
+class alignas(kCacheLineSize) Match {
+public:
+    Match(uint32_t id, size_t player_count);
+    uint32_t GetId() const;
+    size_t GetPlayerCount() const;
+    bool IsFull() const;
+    bool IsRunning() const;
+    bool IsOver() const;
+    // Player that topped out or left, once the match is over.
+    std::optional<size_t> GetLoser() const;
+    const Board<>& GetBoard(size_t player) const;
+
+    // Returns the player index of the new seat.
+    size_t AddPlayer();
+    // Frees a seat before the start, during the match the leaver loses.
+    void RemovePlayer(size_t player);
+    void QueueInput(size_t player, MoveType move);
+    // Spectators get every board's delta each tick, framed as
+    // kSpectatorFrame messages. A new spectator forces keyframes.
+    void AddSpectator();
+    void RemoveSpectator();
+    std::span<const uint8_t> GetSpectatorFeed() const;
+    void Start(const FrameTime& frame_time);
+    // Drops the previous tick's spectator feed, called for every match each tick.
+    void BeginTick();
+    void Step(const FrameTime& frame_time);
+
+private:
+    struct Seat {
+        bool taken = false;
+        std::vector<MoveType> moves;
+        size_t next_target = 0;
+    };
+
+    // Moves a client may queue per tick, the rest are dropped.
+    static constexpr size_t kMaxMovesPerTick_ = 8;
+    const uint32_t id_;
+    std::vector<Board<>> boards_;
+    std::vector<Seat> seats_;
+    std::vector<BoardDeltaEncoder> encoders_;
+    std::vector<uint8_t> spectator_feed_;
+    size_t spectator_count_ = 0;
+    uint32_t tick_ = 0;
+    bool running_ = false;
+    std::optional<size_t> loser_;
+
+    void SendGarbage(size_t player);
+    void EncodeSpectatorFeed();
+};
+
+}
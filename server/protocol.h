@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace game::server {
+
+// Every message is a frame: payload length (u16), type (u8), payload.
+// Integers are little-endian.
+enum class MessageType : uint8_t {
+    // Client to server.
+    kJoin = 1,         // u32 match id, 0 joins any open match
+    kInput = 2,        // u8 MoveType
+    kSpectate = 3,     // u32 match id, 0 watches any running match
+    // Server to client.
+    kJoined = 101,     // u32 match id, u8 player index, u8 player count
+    kMatchStart = 102,
+    kBoardState = 103, // u32 tick, u8 phase, u32 points, u32 cleared lines, u8 level
+    kMatchOver = 104,  // u8 index of the player that topped out or left
+    kSpectatorFrame = 105, // u8 player index, BoardDeltaEncoder message
+};
+
+constexpr size_t kFrameHeaderSize = 3;
+constexpr size_t kMaxPayloadSize = 1024;
+
+class MessageWriter {
+public:
+    MessageWriter(std::vector<uint8_t>& out, MessageType type)
+        : out_(out), start_(out.size()) {
+        this->out_.insert(this->out_.end(), {0, 0, static_cast<uint8_t>(type)});
+    }
+    MessageWriter(const MessageWriter& other) = delete;
+    MessageWriter& operator=(const MessageWriter& other) = delete;
+    // Patches the payload length into the header.
+    ~MessageWriter() {
+        size_t size = this->out_.size() - this->start_ - kFrameHeaderSize;
+        this->out_[this->start_] = static_cast<uint8_t>(size);
+        this->out_[this->start_ + 1] = static_cast<uint8_t>(size >> 8);
+    }
+
+    MessageWriter& U8(uint8_t value) {
+        this->out_.push_back(value);
+        return *this;
+    }
+
+    MessageWriter& U32(uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            this->out_.push_back(static_cast<uint8_t>(value >> shift));
+        }
+        return *this;
+    }
+
+    MessageWriter& Bytes(std::span<const uint8_t> bytes) {
+        this->out_.insert(this->out_.end(), bytes.begin(), bytes.end());
+        return *this;
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+    size_t start_;
+};
+
+class MessageReader {
+public:
+    explicit MessageReader(std::span<const uint8_t> payload) : payload_(payload) {}
+
+    bool U8(uint8_t& value) {
+        if (this->offset_ + 1 > this->payload_.size()) {
+            return false;
+        }
+        value = this->payload_[this->offset_++];
+        return true;
+    }
+
+    bool U32(uint32_t& value) {
+        if (this->offset_ + 4 > this->payload_.size()) {
+            return false;
+        }
+        value = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            value |= static_cast<uint32_t>(this->payload_[this->offset_++]) << shift;
+        }
+        return true;
+    }
+
+private:
+    std::span<const uint8_t> payload_;
+    size_t offset_ = 0;
+};
+
+struct Frame {
+    MessageType type;
+    std::span<const uint8_t> payload;
+    // Bytes of the buffer taken by this frame, header included.
+    size_t size;
+};
+
+// Parses the frame at the start of buffer, nullopt until it is complete.
+inline std::optional<Frame> ParseFrame(std::span<const uint8_t> buffer) {
+    if (buffer.size() < kFrameHeaderSize) {
+        return std::nullopt;
+    }
+    size_t size = buffer[0] | (static_cast<size_t>(buffer[1]) << 8);
+    if (buffer.size() < kFrameHeaderSize + size) {
+        return std::nullopt;
+    }
+    return Frame{static_cast<MessageType>(buffer[2]), buffer.subspan(kFrameHeaderSize, size),
+                 kFrameHeaderSize + size};
+}
+
+}
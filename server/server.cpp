@@ -0,0 +1,379 @@
+#include <algorithm>
+#include <array>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <system_error>
+#include <unistd.h>
+#include "server.h"
+#include "trace.h"
+
+namespace game::server {
+
+namespace {
+
+constexpr int kMaxEvents = 256;
+// A client further behind than this on reading its updates is dropped.
+constexpr size_t kMaxPendingOutput = 1 << 20;
+
+[[noreturn]] void ThrowErrno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+void SetNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        ThrowErrno("fcntl");
+    }
+}
+
+}
+
+Server::Server(const ServerConfig& config)
+    : config_(config), pool_(config.threads) {
+    this->listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (this->listen_fd_ < 0) {
+        ThrowErrno("socket");
+    }
+    int reuse = 1;
+    setsockopt(this->listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.address, &address.sin_addr) != 1) {
+        close(this->listen_fd_);
+        throw std::system_error(EINVAL, std::generic_category(), "inet_pton");
+    }
+    if (bind(this->listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(this->listen_fd_, SOMAXCONN) < 0) {
+        int error = errno;
+        close(this->listen_fd_);
+        throw std::system_error(error, std::generic_category(), "bind");
+    }
+    socklen_t length = sizeof(address);
+    getsockname(this->listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    this->port_ = ntohs(address.sin_port);
+    SetNonBlocking(this->listen_fd_);
+
+    this->epoll_fd_ = epoll_create1(0);
+    if (this->epoll_fd_ < 0) {
+        close(this->listen_fd_);
+        ThrowErrno("epoll_create1");
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = this->listen_fd_;
+    epoll_ctl(this->epoll_fd_, EPOLL_CTL_ADD, this->listen_fd_, &event);
+}
+
+Server::~Server() {
+    for (auto& [fd, connection] : this->connections_) {
+        close(fd);
+    }
+    close(this->epoll_fd_);
+    close(this->listen_fd_);
+}
+
+uint16_t Server::GetPort() const {
+    return this->port_;
+}
+
+void Server::Run(const std::atomic<bool>& stop) {
+    TRACE_THREAD_NAME("server");
+    const auto tick_duration = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / this->config_.ticks_per_second));
+    auto next_tick = Clock::now();
+    std::array<epoll_event, kMaxEvents> events;
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        auto wait = std::chrono::ceil<std::chrono::milliseconds>(next_tick - Clock::now()).count();
+        int count = epoll_wait(this->epoll_fd_, events.data(), kMaxEvents,
+                               static_cast<int>(std::max<decltype(wait)>(wait, 0)));
+        if (count < 0 && errno != EINTR) {
+            ThrowErrno("epoll_wait");
+        }
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == this->listen_fd_) {
+                this->AcceptConnections();
+                continue;
+            }
+            auto connection = this->connections_.find(fd);
+            if (connection == this->connections_.end()) {
+                continue;
+            }
+            if (events[i].events & EPOLLOUT) {
+                connection->second.writable = true;
+                this->QueueOutput(fd);
+            }
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                this->ReadConnection(fd);
+            }
+        }
+
+        auto now = Clock::now();
+        if (now >= next_tick) {
+            this->Tick();
+            // Fixed rate; after a stall resume from now instead of catching up.
+            next_tick = std::max(next_tick + tick_duration, now);
+        }
+
+        auto pending = std::move(this->pending_output_);
+        this->pending_output_.clear();
+        for (int fd : pending) {
+            this->FlushConnection(fd);
+        }
+    }
+}
+
+void Server::AcceptConnections() {
+    while (true) {
+        int fd = accept4(this->listen_fd_, nullptr, nullptr, SOCK_NONBLOCK);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::perror("accept4");
+            }
+            return;
+        }
+        int no_delay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+        event.data.fd = fd;
+        if (epoll_ctl(this->epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+        this->connections_.emplace(fd, Connection{});
+    }
+}
+
+void Server::ReadConnection(int fd) {
+    auto found = this->connections_.find(fd);
+    if (found == this->connections_.end()) {
+        return;
+    }
+    auto& connection = found->second;
+    uint8_t buffer[4096];
+    while (true) {
+        ssize_t size = read(fd, buffer, sizeof(buffer));
+        if (size > 0) {
+            connection.input.insert(connection.input.end(), buffer, buffer + size);
+            continue;
+        }
+        if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        this->CloseConnection(fd);
+        return;
+    }
+
+    size_t offset = 0;
+    while (auto frame = ParseFrame(std::span(connection.input).subspan(offset))) {
+        if (frame->payload.size() > kMaxPayloadSize ||
+            !this->HandleFrame(fd, connection, frame->type, frame->payload)) {
+            this->CloseConnection(fd);
+            return;
+        }
+        offset += frame->size;
+    }
+    connection.input.erase(connection.input.begin(), connection.input.begin() + offset);
+    if (connection.input.size() > kFrameHeaderSize + kMaxPayloadSize) {
+        this->CloseConnection(fd);
+    }
+}
+
+bool Server::HandleFrame(int fd, Connection& connection, MessageType type, std::span<const uint8_t> payload) {
+    MessageReader reader{payload};
+    switch (type) {
+        case MessageType::kJoin: {
+            uint32_t match_id = 0;
+            if (!reader.U32(match_id) || connection.match != nullptr) {
+                return false;
+            }
+            this->JoinMatch(fd, connection, match_id);
+            return true;
+        }
+        case MessageType::kSpectate: {
+            uint32_t match_id = 0;
+            if (!reader.U32(match_id) || connection.match != nullptr || connection.spectating != nullptr) {
+                return false;
+            }
+            this->SpectateMatch(fd, connection, match_id);
+            return true;
+        }
+        case MessageType::kInput: {
+            uint8_t move = 0;
+            if (!reader.U8(move) || move >= static_cast<uint8_t>(MoveType::kNone)) {
+                return false;
+            }
+            if (connection.match != nullptr && connection.match->IsRunning()) {
+                connection.match->QueueInput(connection.player, static_cast<MoveType>(move));
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void Server::JoinMatch(int fd, Connection& connection, uint32_t match_id) {
+    auto open = std::find_if(this->matches_.begin(), this->matches_.end(), [match_id](const auto& match) {
+        return !match->IsRunning() && !match->IsOver() && !match->IsFull() &&
+               (match_id == 0 || match->GetId() == match_id);
+    });
+    Match* match = nullptr;
+    if (open != this->matches_.end()) {
+        match = open->get();
+    }
+    else {
+        this->matches_.push_back(std::make_unique<Match>(this->next_match_id_++, this->config_.players_per_match));
+        match = this->matches_.back().get();
+    }
+    connection.match = match;
+    connection.player = match->AddPlayer();
+    MessageWriter(connection.output, MessageType::kJoined)
+            .U32(match->GetId())
+            .U8(static_cast<uint8_t>(connection.player))
+            .U8(static_cast<uint8_t>(match->GetPlayerCount()));
+    this->QueueOutput(fd);
+
+    if (match->IsFull()) {
+        match->Start(FrameTime{Clock::now(), this->tick_time_.index});
+        this->SendToMatch(*match, MessageType::kMatchStart);
+    }
+}
+
+void Server::SpectateMatch(int fd, Connection& connection, uint32_t match_id) {
+    auto found = std::find_if(this->matches_.begin(), this->matches_.end(), [match_id](const auto& match) {
+        return !match->IsOver() && (match_id == 0 ? match->IsRunning() : match->GetId() == match_id);
+    });
+    if (found == this->matches_.end()) {
+        // Nothing to watch, the client is told right away.
+        MessageWriter(connection.output, MessageType::kMatchOver).U8(UINT8_MAX);
+        this->QueueOutput(fd);
+        return;
+    }
+    connection.spectating = found->get();
+    connection.spectating->AddSpectator();
+}
+
+void Server::Tick() {
+    TRACE_SCOPE("ServerTick");
+    this->tick_time_ = FrameTime{Clock::now(), this->tick_time_.index + 1};
+    this->running_.clear();
+    for (const auto& match : this->matches_) {
+        match->BeginTick();
+        if (match->IsRunning()) {
+            this->running_.push_back(match.get());
+        }
+    }
+    auto step = [this](size_t index) {
+        this->running_[index]->Step(this->tick_time_);
+    };
+    this->pool_.Run(this->running_.size(), step);
+
+    for (auto& [fd, connection] : this->connections_) {
+        if (Match* watched = connection.spectating; watched != nullptr) {
+            auto feed = watched->GetSpectatorFeed();
+            connection.output.insert(connection.output.end(), feed.begin(), feed.end());
+            if (watched->IsOver()) {
+                MessageWriter(connection.output, MessageType::kMatchOver)
+                        .U8(static_cast<uint8_t>(*watched->GetLoser()));
+                connection.spectating = nullptr;
+            }
+            this->QueueOutput(fd);
+            continue;
+        }
+        Match* match = connection.match;
+        if (match == nullptr || (!match->IsRunning() && !match->IsOver())) {
+            continue;
+        }
+        const auto& board = match->GetBoard(connection.player);
+        MessageWriter(connection.output, MessageType::kBoardState)
+                .U32(static_cast<uint32_t>(this->tick_time_.index))
+                .U8(static_cast<uint8_t>(board.GetActualGamePhase()))
+                .U32(static_cast<uint32_t>(board.GetPoints()))
+                .U32(static_cast<uint32_t>(board.GetClearedLineCount()))
+                .U8(static_cast<uint8_t>(board.GetLevel()));
+        if (match->IsOver()) {
+            MessageWriter(connection.output, MessageType::kMatchOver)
+                    .U8(static_cast<uint8_t>(*match->GetLoser()));
+            connection.match = nullptr;
+        }
+        this->QueueOutput(fd);
+    }
+
+    std::erase_if(this->matches_, [](const auto& match) {
+        return match->IsOver();
+    });
+}
+
+void Server::SendToMatch(const Match& match, MessageType type) {
+    for (auto& [fd, connection] : this->connections_) {
+        if (connection.match == &match) {
+            MessageWriter(connection.output, type);
+            this->QueueOutput(fd);
+        }
+    }
+}
+
+void Server::QueueOutput(int fd) {
+    this->pending_output_.push_back(fd);
+}
+
+void Server::FlushConnection(int fd) {
+    auto found = this->connections_.find(fd);
+    if (found == this->connections_.end()) {
+        return;
+    }
+    auto& connection = found->second;
+    size_t offset = 0;
+    while (connection.writable && offset < connection.output.size()) {
+        ssize_t size = send(fd, connection.output.data() + offset, connection.output.size() - offset, MSG_NOSIGNAL);
+        if (size > 0) {
+            offset += static_cast<size_t>(size);
+        }
+        else if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // Edge-triggered EPOLLOUT reports when the socket drains.
+            connection.writable = false;
+        }
+        else if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        else {
+            this->CloseConnection(fd);
+            return;
+        }
+    }
+    connection.output.erase(connection.output.begin(), connection.output.begin() + offset);
+    if (connection.output.size() > kMaxPendingOutput) {
+        this->CloseConnection(fd);
+    }
+}
+
+void Server::CloseConnection(int fd) {
+    auto found = this->connections_.find(fd);
+    if (found == this->connections_.end()) {
+        return;
+    }
+    if (found->second.match != nullptr) {
+        found->second.match->RemovePlayer(found->second.player);
+    }
+    if (found->second.spectating != nullptr) {
+        found->second.spectating->RemoveSpectator();
+    }
+    this->connections_.erase(found);
+    close(fd);
+}
+
+}
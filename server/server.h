@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "match.h"
+#include "protocol.h"
+#include "worker_pool.h"
+
+namespace game::server {
+
+struct ServerConfig {
+    // Loopback by default, the server trusts its clients.
+    const char* address = "127.0.0.1";
+    uint16_t port = 7777;
+    size_t players_per_match = 2;
+    int ticks_per_second = 60;
+    size_t threads = 1;
+};
+
+// Hosts matches for TCP clients. One thread runs the epoll loop and all socket
+// I/O; every tick the running matches are stepped in parallel on a worker pool.
+// Throws std::system_error when the listening socket cannot be set up.
+class Server {
+public:
+    explicit Server(const ServerConfig& config);
+    Server(const Server& other) = delete;
+    Server& operator=(const Server& other) = delete;
+    ~Server();
+    // Serves until stop becomes true.
+    void Run(const std::atomic<bool>& stop);
+    uint16_t GetPort() const;
+
+private:
+    struct Connection {
+        std::vector<uint8_t> input;
+        std::vector<uint8_t> output;
+        Match* match = nullptr;
+        Match* spectating = nullptr;
+        size_t player = 0;
+        bool writable = true;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    const ServerConfig config_;
+    int listen_fd_ = -1;
+    int epoll_fd_ = -1;
+    uint16_t port_ = 0;
+    uint32_t next_match_id_ = 1;
+    FrameTime tick_time_{};
+    WorkerPool pool_;
+    std::unordered_map<int, Connection> connections_;
+    std::vector<std::unique_ptr<Match>> matches_;
+    std::vector<Match*> running_;
+    // Connections with output waiting, flushed once per loop iteration.
+    std::vector<int> pending_output_;
+
+    void AcceptConnections();
+    void ReadConnection(int fd);
+    void FlushConnection(int fd);
+    void CloseConnection(int fd);
+    bool HandleFrame(int fd, Connection& connection, MessageType type, std::span<const uint8_t> payload);
+    void JoinMatch(int fd, Connection& connection, uint32_t match_id);
+    void SpectateMatch(int fd, Connection& connection, uint32_t match_id);
+    void Tick();
+    void SendToMatch(const Match& match, MessageType type);
+    void QueueOutput(int fd);
+};
+
+}
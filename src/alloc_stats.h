@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace game::alloc_stats {
+
+struct Snapshot {
+    size_t allocations;
+    size_t deallocations;
+    size_t bytes;
+};
+
+// Totals of global operator new/delete calls since program start.
+Snapshot Current();
+
+}
@@ -0,0 +1,105 @@
+#include "auto_shift.h"
+
+namespace game {
+
+AutoShift::AutoShift(AutoShiftSettings settings) {
+    this->SetSettings(settings);
+}
+
+void AutoShift::SetSettings(AutoShiftSettings settings) {
+    this->count_frames_ = false;
+    this->delay_ = settings.delay.count();
+    this->repeat_ = settings.repeat.count();
+}
+
+void AutoShift::SetSettings(AutoShiftFrames frames) {
+    this->count_frames_ = true;
+    this->delay_ = frames.delay;
+    this->repeat_ = frames.repeat;
+}
+
+int64_t AutoShift::GetStamp(const FrameTime& time) const {
+    if (this->count_frames_) {
+        return static_cast<int64_t>(time.index);
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.now.time_since_epoch()).count();
+}
+
+void AutoShift::Press(MoveType direction, const FrameTime& time) {
+    if (direction == MoveType::kLeft) {
+        this->left_held_ = true;
+    }
+    else if (direction == MoveType::kRight) {
+        this->right_held_ = true;
+    }
+    else {
+        return;
+    }
+    this->direction_ = direction;
+    this->charged_ = false;
+    this->next_shift_ = this->GetStamp(time);
+}
+
+void AutoShift::Release(MoveType direction, const FrameTime& time) {
+    if (direction == MoveType::kLeft) {
+        this->left_held_ = false;
+    }
+    else if (direction == MoveType::kRight) {
+        this->right_held_ = false;
+    }
+    if (direction != this->direction_) {
+        return;
+    }
+    this->direction_ = MoveType::kNone;
+    if (this->left_held_ || this->right_held_) {
+        // The other key is still down and takes over without a tap shift.
+        this->Charge(this->left_held_ ? MoveType::kLeft : MoveType::kRight, this->GetStamp(time));
+    }
+}
+
+void AutoShift::Charge(MoveType direction, int64_t stamp) {
+    this->direction_ = direction;
+    this->charged_ = true;
+    this->next_shift_ = stamp + (this->delay_ > 0 ? this->delay_ : this->repeat_);
+}
+
+uint32_t AutoShift::Advance(const FrameTime& time) {
+    if (this->direction_ == MoveType::kNone) {
+        return 0;
+    }
+    const int64_t stamp = this->GetStamp(time);
+    uint32_t shifts = 0;
+    while (this->next_shift_ <= stamp) {
+        if (this->charged_ && this->repeat_ == 0) {
+            // next_shift_ stays due, every later Advance goes to the wall again.
+            return kToWall;
+        }
+        if (shifts == kMaxShifts_) {
+            // More shifts than reach any wall, skip the rest instead of queueing them.
+            this->next_shift_ += ((stamp - this->next_shift_) / this->repeat_ + 1) * this->repeat_;
+            return kToWall;
+        }
+        ++shifts;
+        if (this->charged_) {
+            this->next_shift_ += this->repeat_;
+        }
+        else {
+            // The tap shift, repeats start once the delay has passed.
+            this->Charge(this->direction_, this->next_shift_);
+        }
+    }
+    return shifts;
+}
+
+MoveType AutoShift::GetDirection() const {
+    return this->direction_;
+}
+
+void AutoShift::Reset() {
+    this->left_held_ = false;
+    this->right_held_ = false;
+    this->direction_ = MoveType::kNone;
+    this->charged_ = false;
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include "common.h"
+#include "nes_timing.h"
+
+namespace game {
+
+// Delayed auto shift (delay) and auto repeat rate (repeat) of a held
+// direction. A repeat of zero moves the piece to the wall as soon as the
+// delay has passed.
+struct AutoShiftSettings {
+    std::chrono::nanoseconds delay;
+    std::chrono::nanoseconds repeat;
+};
+
+// The same in whole simulation ticks, for TimingModel::kNesFrames.
+struct AutoShiftFrames {
+    uint32_t delay;
+    uint32_t repeat;
+};
+
+inline constexpr AutoShiftSettings kDefaultAutoShift{std::chrono::milliseconds(167), std::chrono::milliseconds(33)};
+
+// The NES charges for 16 frames and then shifts every 6.
+inline constexpr AutoShiftFrames kNesAutoShift{nes::kDasDelayFrames, nes::kDasRepeatFrames};
+
+// Turns timestamped presses and releases of left and right into shifts. A
+// press shifts once, the held key shifts again after the delay and then
+// every repeat. With AutoShiftSettings shift times are computed from the
+// press time, never from when Advance is called, so the shifts of a key held
+// for a given time do not depend on the tick rate and several may fall into
+// one tick. With AutoShiftFrames they are counted in FrameTime::index from
+// the tick that took the press, like the board's NES frame counters. When
+// both keys are held the last pressed one wins; releasing it charges the
+// other again.
+class AutoShift {
+public:
+    explicit AutoShift(AutoShiftSettings settings = kDefaultAutoShift);
+    void SetSettings(AutoShiftSettings settings);
+    void SetSettings(AutoShiftFrames frames);
+    // direction is kLeft or kRight, anything else is ignored. Call Advance
+    // up to time first so earlier shifts are not skipped.
+    void Press(MoveType direction, const FrameTime& time);
+    void Release(MoveType direction, const FrameTime& time);
+    // Returned by Advance when the piece should go all the way to the wall:
+    // always once the delay has passed with a repeat of zero, and whenever
+    // more shifts are due than cross the widest board.
+    static constexpr uint32_t kToWall = UINT32_MAX;
+    // Number of shifts due up to and including time, in GetDirection, or
+    // kToWall.
+    uint32_t Advance(const FrameTime& time);
+    // kNone while no key is held.
+    MoveType GetDirection() const;
+    // Forgets held keys, for when presses or releases were missed.
+    void Reset();
+
+private:
+    // Most single shifts one Advance returns, enough to cross the widest board.
+    static constexpr uint32_t kMaxShifts_ = 23;
+    // Times below are nanoseconds since the clock's epoch, or tick indices
+    // when counting frames.
+    bool count_frames_ = false;
+    int64_t delay_ = 0;
+    int64_t repeat_ = 0;
+    bool left_held_ = false;
+    bool right_held_ = false;
+    MoveType direction_ = MoveType::kNone;
+    bool charged_ = false;
+    int64_t next_shift_ = 0;
+
+    int64_t GetStamp(const FrameTime& time) const;
+    void Charge(MoveType direction, int64_t stamp);
+};
+
+}
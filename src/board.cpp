@@ -1,86 +1,208 @@
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <random>
 #include "board.h"
+#include "nes_timing.h"
+#include "profiler.h"
+#include "trace.h"
 
 namespace game {
 
-using RandGenType = std::mt19937_64;
+namespace {
 
-std::random_device rd{};
-RandGenType rand_gen{rd()};
-std::uniform_int_distribution<uint8_t> uniform_dist(0, static_cast<int>(game::Shape::kNumOfShapes) - 1);
+// One random_device draw at startup, then a different seed for every board.
+std::atomic<uint32_t> next_board_seed{std::random_device{}()};
 
-Board::Board() :
-        board_(this->height_, std::vector<uint8_t>(this->width_)) {
-    this->lines_to_clear_.reserve(this->height_);
-    Piece::MakeAllRotations();
-    this->MakePiece(0, this->width_ / 2 - 1);
+uint32_t NextBoardSeed() {
+    return next_board_seed.fetch_add(0x9E3779B9u, std::memory_order_relaxed);
 }
 
-void Board::SetValue(const int row, const int col, const uint8_t value) {
-    this->board_.at(row).at(col) = value;
 }
 
-uint8_t Board::GetValue(const int row, const int col) const{
-    return this->board_.at(row).at(col);
+template class Board<10, 22>;
+template class Board<16, 22>;
+template class Board<10, 40>;
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+Board<W, H>::Board()
+    : seed_(NextBoardSeed()) {
+    this->Reseed(this->seed_);
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::SetPreviewDepth(size_t depth) {
+    this->preview_depth_ = std::clamp(depth, PieceQueue::kMinPreview, PieceQueue::kMaxPreview);
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+size_t Board<W, H>::GetPreviewDepth() const {
+    return this->preview_depth_;
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+Shape Board<W, H>::GetPreviewShape(size_t index) const {
+    assert(index < this->preview_depth_);
+    return this->queue_.Peek(index);
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+std::optional<Shape> Board<W, H>::GetHeldShape() const {
+    return this->held_shape_;
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::SetTimingModel(TimingModel timing) {
+    this->timing_ = timing;
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+TimingModel Board<W, H>::GetTimingModel() const {
+    return this->timing_;
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::Reseed(uint32_t seed) {
+    this->seed_ = seed;
+    this->rand_gen_.seed(seed);
+    this->queue_.Clear();
+    this->queue_.Fill([this] { return this->SelectRandomPiece(); });
+    this->held_shape_.reset();
+    this->MakePiece(0, this->kWidth_ / 2 - 1);
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+uint32_t Board<W, H>::GetSeed() const {
+    return this->seed_;
 }
 
-bool Board::CheckPieceValid(const Board::PieceState piece) const {
-    assert(&piece.piece);
-    auto shape = piece.piece->GetPiece().get();
-    uint16_t size = piece.piece->GetDim();
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::SetValue(const int row, const int col, const uint8_t value) {
+    assert(row >= 0 && row < this->kHeight_ && col >= 0 && col < this->kWidth_);
+    this->board_[row * this->kWidth_ + col] = value;
+    if (value) {
+        this->row_masks_[row] |= 1u << col;
+    }
+    else {
+        this->row_masks_[row] &= ~(1u << col);
+    }
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+uint8_t Board<W, H>::GetValue(const int row, const int col) const{
+    assert(row >= 0 && row < this->kHeight_ && col >= 0 && col < this->kWidth_);
+    return this->board_[row * this->kWidth_ + col];
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+bool Board<W, H>::CheckPieceValid(const PieceState piece) const {
+    // Row masks are shifted past a padding of wall bits on both sides, so a
+    // piece row hits a wall or a cell with a single AND.
+    const int shift = piece.offset_col + kWallPadding_;
+    if (shift < 0) {
+        return false;
+    }
+    const auto& masks = piece.piece.GetRowMasks();
+    uint16_t size = piece.piece.GetDim();
     for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            uint8_t value = *shape++;
-            if (value) {
-                int board_row = piece.offset_row + i;
-                int board_col = piece.offset_col + j;
-                if (board_row < 0) return false;
-                if (board_row >= this->height_) return false;
-                if (board_col < 0) return false;
-                if (board_col >= this->width_) return false;
-                if (this->GetValue(board_row, board_col)) return false;
-            }
+        if (!masks[i]) {
+            continue;
+        }
+        int board_row = piece.offset_row + i;
+        if (board_row < 0 || board_row >= this->kHeight_) {
+            return false;
+        }
+        uint64_t blocked = kWallMask_ | (static_cast<uint64_t>(this->row_masks_[board_row]) << kWallPadding_);
+        if ((static_cast<uint64_t>(masks[i]) << shift) & blocked) {
+            return false;
         }
     }
     return true;
 }
 
-void Board::MakePiece(int offset_row, int offset_col) {
-    if (this->next_piece_ == nullptr) {
-        auto shape = this->SelectRandomPiece();
-        this->next_piece_ = std::make_unique<PieceState>(PieceState{std::make_shared<Piece>(Piece{shape}), offset_row, offset_col});
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::MakePiece(int offset_row, int offset_col) {
+    this->actual_piece_ = PieceState{Piece{this->queue_.Pop()}, offset_row, offset_col};
+    TRACE_INSTANT("PieceSpawn", static_cast<int>(this->actual_piece_.piece.GetShape()));
+    this->queue_.Fill([this] { return this->SelectRandomPiece(); });
+    this->hold_used_ = false;
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::HoldPiece() {
+    // Once per piece, until it locks.
+    if (this->hold_used_) {
+        return;
+    }
+    Shape incoming = this->held_shape_ ? *this->held_shape_ : this->queue_.Peek(0);
+    PieceState spawned{Piece{incoming}, 0, this->kWidth_ / 2 - 1};
+    if (!this->CheckPieceValid(spawned)) {
+        return;
+    }
+    if (!this->held_shape_) {
+        this->queue_.Pop();
+        this->queue_.Fill([this] { return this->SelectRandomPiece(); });
     }
-    this->actual_piece_ = std::move(this->next_piece_);
-    auto next_shape = this->SelectRandomPiece();
-    this->next_piece_ = std::make_unique<PieceState>(PieceState{std::make_shared<Piece>(Piece{next_shape}), offset_row, offset_col});
+    this->held_shape_ = this->actual_piece_.piece.GetShape();
+    this->actual_piece_ = spawned;
+    this->hold_used_ = true;
 }
 
-void Board::MovePieceLeft() {
-    PieceState tmp = *this->actual_piece_;
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+bool Board<W, H>::MovePieceLeft() {
+    PieceState tmp = this->actual_piece_;
     --tmp.offset_col;
-    if (this->CheckPieceValid(tmp)) {
-        --this->actual_piece_->offset_col;
+    if (!this->CheckPieceValid(tmp)) {
+        return false;
     }
+    --this->actual_piece_.offset_col;
+    return true;
 }
 
-void Board::MovePieceRight() {
-    PieceState tmp = *this->actual_piece_;
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+bool Board<W, H>::MovePieceRight() {
+    PieceState tmp = this->actual_piece_;
     ++tmp.offset_col;
-    if (this->CheckPieceValid(tmp)) {
-        ++this->actual_piece_->offset_col;
+    if (!this->CheckPieceValid(tmp)) {
+        return false;
     }
+    ++this->actual_piece_.offset_col;
+    return true;
 }
 
-void Board::RotatePiece() {
-    PieceState tmp = *this->actual_piece_;
-    tmp.piece = tmp.piece->FastRotation().lock();
-    if (this->CheckPieceValid(tmp)) {
-        this->actual_piece_->piece = this->actual_piece_->piece->FastRotation().lock();
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::RotatePiece(Turn turn) {
+    const Piece rotated = this->actual_piece_.piece.Rotated(GetQuarterTurns(turn));
+    // The first test that fits wins, a rotation with no fitting test fails.
+    for (const Kick& kick : GetKicks(this->actual_piece_.piece, turn)) {
+        PieceState tmp{rotated, this->actual_piece_.offset_row + kick.row, this->actual_piece_.offset_col + kick.col};
+        if (this->CheckPieceValid(tmp)) {
+            this->actual_piece_ = tmp;
+            return;
+        }
     }
 }
 
-void Board::MovePiece(const MoveType move) {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::MovePiece(const MoveType move) {
     switch (move) {
         case MoveType::kLeft:
             this->MovePieceLeft();
@@ -89,7 +211,24 @@ void Board::MovePiece(const MoveType move) {
             this->MovePieceRight();
             break;
         case MoveType::kUp:
-            this->RotatePiece();
+            this->RotatePiece(Turn::kClockwise);
+            break;
+        case MoveType::kRotateCcw:
+            this->RotatePiece(Turn::kCounterClockwise);
+            break;
+        case MoveType::kRotate180:
+            this->RotatePiece(Turn::kHalf);
+            break;
+        case MoveType::kHold:
+            this->HoldPiece();
+            break;
+        case MoveType::kLeftWall:
+            while (this->MovePieceLeft()) {
+            }
+            break;
+        case MoveType::kRightWall:
+            while (this->MovePieceRight()) {
+            }
             break;
         case MoveType::kDown:
             SoftDrop();
@@ -101,151 +240,245 @@ void Board::MovePiece(const MoveType move) {
     }
 }
 
-bool Board::SoftDrop() {
-    ++this->actual_piece_->offset_row;
-    if (!this->CheckPieceValid(*this->actual_piece_)) {
-        --this->actual_piece_->offset_row;
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+bool Board<W, H>::SoftDrop() {
+    ++this->actual_piece_.offset_row;
+    if (!this->CheckPieceValid(this->actual_piece_)) {
+        --this->actual_piece_.offset_row;
         this->MergePieceIntoBoard();
-        this->MakePiece(0, this->width_ / 2 - 1);
+        this->MakePiece(0, this->kWidth_ / 2 - 1);
         return false;
     }
     return true;
 }
 
-void Board::MergePieceIntoBoard() {
-    auto shape = this->actual_piece_->piece->GetPiece().get();
-    uint16_t size = this->actual_piece_->piece->GetDim();
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::MergePieceIntoBoard() {
+    auto shape = this->actual_piece_.piece.GetPiece();
+    uint16_t size = this->actual_piece_.piece.GetDim();
+    int lock_row = 0;
     for (int i = 0; i < size; ++i) {
         for (int j = 0; j < size; ++j) {
             uint8_t value = *shape++;
             if (value) {
-                int board_row = this->actual_piece_->offset_row + i;
-                int board_col = this->actual_piece_->offset_col + j;
+                int board_row = this->actual_piece_.offset_row + i;
+                int board_col = this->actual_piece_.offset_col + j;
                 this->SetValue(board_row, board_col, value);
+                lock_row = std::max(lock_row, board_row);
             }
         }
     }
+    this->lock_row_ = lock_row;
+    this->locked_row_begin_ = std::min(this->locked_row_begin_, std::max(this->actual_piece_.offset_row, 0));
+    this->locked_row_end_ = std::max(this->locked_row_end_,
+                                     std::min(this->actual_piece_.offset_row + size, static_cast<int>(this->kHeight_)));
 }
 
-Shape Board::SelectRandomPiece() {
-    uint8_t number = uniform_dist( rand_gen);
-    return static_cast<game::Shape>(number);
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::InsertGarbage() {
+    uint32_t lines = this->incoming_garbage_.Take();
+    if (lines == 0) {
+        return;
+    }
+    lines = std::min<uint32_t>(lines, this->kHeight_);
+    TRACE_INSTANT("GarbageReceived", lines);
+
+    // Rows pushed above the top mean the stack topped out.
+    bool pushed_out = false;
+    for (uint32_t row = 0; row < lines; ++row) {
+        pushed_out |= !this->CheckRowEmpty(row);
+    }
+    const int kept_rows = this->kHeight_ - lines;
+    std::copy_n(this->board_.begin() + lines * this->kWidth_, kept_rows * this->kWidth_, this->board_.begin());
+    std::copy_n(this->row_masks_.begin() + lines, kept_rows, this->row_masks_.begin());
+
+    // One hole column per attack, so the garbage can be dug out.
+    std::uniform_int_distribution<int> hole_dist(0, this->kWidth_ - 1);
+    const int hole = hole_dist(this->rand_gen_);
+    for (int row = kept_rows; row < this->kHeight_; ++row) {
+        auto cells = this->board_.begin() + row * this->kWidth_;
+        std::fill_n(cells, this->kWidth_, kGarbageCell);
+        cells[hole] = 0;
+        this->row_masks_[row] = this->kFullRow_ & ~(1u << hole);
+    }
+
+    if (pushed_out || !this->CheckPieceValid(this->actual_piece_)) {
+        this->SetNextGamePhase(GameState::kGameOverPhase);
+    }
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+Shape Board<W, H>::SelectRandomPiece() {
+    std::uniform_int_distribution<int> uniform_dist(0, static_cast<int>(game::Shape::kNumOfShapes) - 1);
+    return static_cast<game::Shape>(uniform_dist(this->rand_gen_));
 }
 
-std::shared_ptr<tetrino[]> Board::GetPiece(const PieceType type) const {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+const tetrino* Board<W, H>::GetPiece(const PieceType type) const {
     switch (type) {
         case PieceType::kActualPiece:
-            return this->actual_piece_->piece->GetPiece();
+            return this->actual_piece_.piece.GetPiece();
         case PieceType::kNextPiece:
-            return this->next_piece_->piece->GetPiece();
+            return Piece{this->queue_.Peek(0)}.GetPiece();
     }
     return nullptr;
 }
 
-int Board::GetPieceRowPosition(const PieceType type) const {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+int Board<W, H>::GetPieceRowPosition(const PieceType type) const {
     switch (type) {
         case PieceType::kActualPiece:
-            return this->actual_piece_->offset_row;
+            return this->actual_piece_.offset_row;
         case PieceType::kNextPiece:
-            return this->next_piece_->offset_row;
+            return 0;
     }
     return 0;
 }
 
-int Board::GetPieceColumnPosition(const PieceType type) const{
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+int Board<W, H>::GetPieceColumnPosition(const PieceType type) const{
     switch (type) {
         case PieceType::kActualPiece:
-            return this->actual_piece_->offset_col;
+            return this->actual_piece_.offset_col;
         case PieceType::kNextPiece:
-            return this->next_piece_->offset_col;
+            return this->kWidth_ / 2 - 1;
     }
     return 0;
 }
 
-uint16_t Board::GetPieceSize(const PieceType type) const{
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+uint16_t Board<W, H>::GetPieceSize(const PieceType type) const{
     switch (type) {
         case PieceType::kActualPiece:
-            return this->actual_piece_->piece->GetDim();
+            return this->actual_piece_.piece.GetDim();
         case PieceType::kNextPiece:
-            return this->next_piece_->piece->GetDim();
+            return Piece{this->queue_.Peek(0)}.GetDim();
     }
     return 0;
 }
 
-uint8_t Board::GetBoardHeight() const {
-    return this->height_;
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+Shape Board<W, H>::GetPieceShape(const PieceType type) const {
+    switch (type) {
+        case PieceType::kActualPiece:
+            return this->actual_piece_.piece.GetShape();
+        case PieceType::kNextPiece:
+            return this->queue_.Peek(0);
+    }
+    return Shape::kSquare;
 }
 
-uint8_t Board::GetBoardWidth() const {
-    return this->width_;
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+uint8_t Board<W, H>::GetPieceRotation(const PieceType type) const {
+    switch (type) {
+        case PieceType::kActualPiece:
+            return this->actual_piece_.piece.GetRotation();
+        case PieceType::kNextPiece:
+            return 0;
+    }
+    return 0;
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+uint8_t Board<W, H>::GetBoardHeight() const {
+    return this->kHeight_;
 }
 
-std::vector<std::vector<uint8_t>> Board::GetBoard() const {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+uint8_t Board<W, H>::GetBoardWidth() const {
+    return this->kWidth_;
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+std::span<const uint8_t> Board<W, H>::GetBoard() const {
     return this->board_;
 }
 
-void Board::HardDrop() {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::HardDrop() {
     while (SoftDrop());
 }
 
-bool Board::CheckRowFilled(const int& row) const {
-    for (int i = 0; i < this->width_; ++i) {
-        if (!this->GetValue(row, i)) {
-            return false;
-        }
-    }
-    return true;
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+bool Board<W, H>::CheckRowFilled(const int& row) const {
+    return this->row_masks_[row] == kFullRow_;
 }
 
-int Board::FindLinesToClear() {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+int Board<W, H>::FindLinesToClear() {
     int count = 0;
-    for (int i = 0; i < this->height_; ++i) {
+    for (int i = this->locked_row_begin_; i < this->locked_row_end_; ++i) {
         this->lines_to_clear_[i] = this->CheckRowFilled(i);
         if (this->lines_to_clear_[i]) {
             ++count;
         }
     }
+    this->locked_row_begin_ = this->kHeight_;
+    this->locked_row_end_ = 0;
     return count;
 }
 
-void Board::ClearLines() {
-    int src_row = this->height_ - 1;
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::ClearLines() {
+    PROFILE_ZONE(profiler::Zone::kLineClear);
+    int src_row = this->kHeight_ - 1;
     for (int dest_row = src_row; dest_row >= 0; --dest_row) {
         while (src_row > 0 && this->lines_to_clear_[src_row]) {
             --src_row;
         }
+        auto dest = this->board_.begin() + dest_row * this->kWidth_;
         if (src_row < 0) {
-            std::fill(this->board_.at(dest_row).begin(),
-                      this->board_.at(dest_row).end(), 0);
+            std::fill_n(dest, this->kWidth_, 0);
+            this->row_masks_[dest_row] = 0;
         }
         else {
-            std::copy(this->board_.at(src_row).begin(),
-                      this->board_.at(src_row).end(),
-                      this->board_.at(dest_row).begin());
+            std::copy_n(this->board_.begin() + src_row * this->kWidth_, this->kWidth_, dest);
+            this->row_masks_[dest_row] = this->row_masks_[src_row];
             --src_row;
         }
     }
+    this->lines_to_clear_.fill(false);
 }
 
-size_t Board::GetClearedLineCount() const {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+size_t Board<W, H>::GetClearedLineCount() const {
     return this->cleared_line_count_;
 }
 
-bool Board::IsLineClearing(int index) const {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+bool Board<W, H>::IsLineClearing(int index) const {
     return this->lines_to_clear_[index];
 }
 
-bool Board::CheckRowEmpty(int row) const {
-    for (int i = 0; i < this->width_; ++i) {
-        if (this->GetValue(row, i)) {
-            return false;
-        }
-    }
-    return true;
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+bool Board<W, H>::CheckRowEmpty(int row) const {
+    return this->row_masks_[row] == 0;
 }
 
-int Board::GetShadowPieceRowPosition(){
-    auto shadow_piece = *this->actual_piece_;
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+int Board<W, H>::GetShadowPieceRowPosition(){
+    auto shadow_piece = this->actual_piece_;
     while (this->CheckPieceValid(shadow_piece)) {
         ++shadow_piece.offset_row;
     }
@@ -253,11 +486,17 @@ int Board::GetShadowPieceRowPosition(){
     return shadow_piece.offset_row;
 }
 
-GameState Board::UpdateGame(MoveType input) {
-    this->current_time_ = std::chrono::steady_clock::now();
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+GameState Board<W, H>::UpdateGame(MoveType input, const FrameTime& frame_time) {
+    this->current_time_ = frame_time.now;
     this->time_duration_ =
             std::chrono::duration_cast<std::chrono::duration<float>>
                     (this->current_time_ -this->start_time_).count();
+    if (this->timing_ == TimingModel::kNesFrames && frame_time.index != this->last_tick_index_) {
+        ++this->frame_;
+        this->last_tick_index_ = frame_time.index;
+    }
     switch (this->game_phase_) {
         case GameState::kGameStartPhase:
             this->UpdateGameStart();
@@ -278,31 +517,83 @@ GameState Board::UpdateGame(MoveType input) {
     return this->game_phase_;
 }
 
-GameState Board::GetActualGamePhase() const {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+bool Board<W, H>::CanShift(MoveType direction, const FrameTime& frame_time) const {
+    if (this->game_phase_ != GameState::kGamePlayPhase) {
+        return false;
+    }
+    if (this->timing_ == TimingModel::kNesFrames) {
+        // The frame UpdateGame would count for frame_time.
+        uint64_t frame = this->frame_ + (frame_time.index != this->last_tick_index_ ? 1 : 0);
+        if (frame < this->entry_frame_) {
+            return false;
+        }
+    }
+    PieceState tmp = this->actual_piece_;
+    tmp.offset_col += direction == MoveType::kLeft ? -1 : 1;
+    return this->CheckPieceValid(tmp);
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+GameState Board<W, H>::GetActualGamePhase() const {
     return this->game_phase_;
 }
 
-size_t Board::GetStartLevel() const {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+size_t Board<W, H>::GetStartLevel() const {
     return this->start_level_;
 }
 
-size_t Board::GetLevel() const {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+size_t Board<W, H>::GetLevel() const {
     return this->level_;
 }
 
-size_t Board::GetPoints() const {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+size_t Board<W, H>::GetPoints() const {
     return this->points_;
 }
 
-void Board::UpdateGameplay(const MoveType input) {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::UpdateGameplay(const MoveType input) {
+    const bool nes_timing = this->timing_ == TimingModel::kNesFrames;
+    if (nes_timing && this->frame_ < this->entry_frame_) {
+        // Entry delay, the next piece takes no input yet.
+        return;
+    }
     this->MovePiece(input);
-    if (this->time_duration_ >= this->next_drop_time_) {
+    if (nes_timing) {
+        // A piece locked by the move waits for the entry delay, not gravity.
+        if (this->locked_row_begin_ >= this->locked_row_end_ && this->frame_ >= this->next_drop_frame_) {
+            this->SetNextDrop();
+        }
+    }
+    else if (this->time_duration_ >= this->next_drop_time_) {
         this->SetNextDrop();
     }
+    // The board only changes when a piece locks, nothing to check until then.
+    if (this->locked_row_begin_ >= this->locked_row_end_) {
+        return;
+    }
     this->pending_line_count_ = FindLinesToClear();
     if (this->pending_line_count_ > 0) {
         this->SetNextGamePhase(GameState::kGameLinePhase);
         this->highlight_end_time_ = this->time_duration_ + 0.5f;
+        this->line_clear_end_frame_ = this->frame_ + nes::LineClearFrames(this->frame_);
+    }
+    else {
+        this->InsertGarbage();
+    }
+    if (nes_timing) {
+        uint64_t delay_start = this->pending_line_count_ > 0 ? this->line_clear_end_frame_ : this->frame_;
+        this->entry_frame_ = delay_start + nes::EntryDelayFrames(this->kHeight_ - 1 - this->lock_row_);
+        this->next_drop_frame_ = this->entry_frame_ + this->GetFramesPerDrop();
     }
     int game_over_row = 0;
     if (!this->CheckRowEmpty(game_over_row)) {
@@ -310,45 +601,78 @@ void Board::UpdateGameplay(const MoveType input) {
     }
 }
 
-void Board::SetNextDrop() {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::SetNextDrop() {
     this->next_drop_time_ = 0;
+    this->next_drop_frame_ = 0;
     if (this->SoftDrop()) {
         this->next_drop_time_ = this->time_duration_ + this->GetTimeToNextDrop();
+        this->next_drop_frame_ = this->frame_ + this->GetFramesPerDrop();
     }
 }
 
-void Board::UpdateGameStart() {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::UpdateGameStart() {
     this->level_ = this->start_level_;
     this->points_ = 0;
-    this->start_time_ = std::chrono::steady_clock::now();
+    this->start_time_ = this->current_time_;
+    this->frame_ = 0;
+    this->next_drop_frame_ = 0;
+    this->entry_frame_ = 0;
 }
 
-void Board::UpdateGameOver() {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::UpdateGameOver() {
     this->BoardClean();
 }
 
-void Board::UpdateGameLines() {
-    if (this->time_duration_ >= this->highlight_end_time_) {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::UpdateGameLines() {
+    const bool done = this->timing_ == TimingModel::kNesFrames ? this->frame_ >= this->line_clear_end_frame_
+                                                                : this->time_duration_ >= this->highlight_end_time_;
+    if (done) {
         this->ClearLines();
+        TRACE_INSTANT("LinesCleared", this->pending_line_count_);
         this->cleared_line_count_ += this->pending_line_count_;
         this->points_ += this->ComputePoints();
+        this->outgoing_lines_ += this->attack_table_[std::min<size_t>(this->pending_line_count_, 4)];
         this->LevelUp();
+        this->next_drop_frame_ = this->entry_frame_ + this->GetFramesPerDrop();
         this->SetNextGamePhase(GameState::kGamePlayPhase);
     }
 }
 
-float Board::GetTimeToNextDrop() {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+float Board<W, H>::GetTimeToNextDrop() {
     if (this->level_ > 29) {
         this->level_ = 29;
     }
     return static_cast<float>(this->kFramesPerDrop[this->level_]) * this->kTargetSecondsPerFrame;
 }
 
-void Board::SetNextGamePhase(const GameState game_phase) {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+uint64_t Board<W, H>::GetFramesPerDrop() const {
+    return this->kFramesPerDrop[std::min<size_t>(this->level_, 29)];
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::SetNextGamePhase(const GameState game_phase) {
+    if (game_phase != this->game_phase_) {
+        TRACE_INSTANT(GetGameStateName(game_phase), 0);
+    }
     this->game_phase_ = game_phase;
 }
 
-size_t Board::ComputePoints() const {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+size_t Board<W, H>::ComputePoints() const {
     switch (this->pending_line_count_) {
         case 1:
             return 40 * (this->level_ + 1);
@@ -363,7 +687,9 @@ size_t Board::ComputePoints() const {
     }
 }
 
-size_t Board::GetLinesForNextLevel() const{
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+size_t Board<W, H>::GetLinesForNextLevel() const{
     const int max_condition = static_cast<int>(this->start_level_ * 10 - 50);
     const int min_condition = static_cast<int>(this->start_level_ * 10 - 10);
     int max = 100 > max_condition ? 100 : max_condition;
@@ -377,89 +703,129 @@ size_t Board::GetLinesForNextLevel() const{
     return first_level_up_limit;
 }
 
-void Board::LevelUp() {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::LevelUp() {
     if (this->cleared_line_count_ >= this->GetLinesForNextLevel()) {
         ++this->level_;
     }
 }
 
-void Board::BoardClean() {
-    Board tmp{};
-    tmp.start_level_ = this->start_level_;
-    *this = tmp;
-}
-
-Board::Board(const Board& other) {
-    this->pending_line_count_ = other.pending_line_count_;
-    this->cleared_line_count_ = other.cleared_line_count_;
-    this->points_ = other.points_;
-    this->level_ = other.level_;
-    this->start_level_ = other.start_level_;
-    this->game_phase_ = other.game_phase_;
-    this->next_drop_time_ = other.next_drop_time_;
-    this->time_duration_ = other.time_duration_;
-    this->highlight_end_time_ = other.highlight_end_time_;
-    this->start_time_ = other.start_time_;
-    this->current_time_ = other.current_time_;
-    this->lines_to_clear_.reserve(other.lines_to_clear_.capacity());
-    std::copy(other.lines_to_clear_.begin(), other.lines_to_clear_.end(),
-              std::back_inserter(this->lines_to_clear_));
-    this->board_.reserve(other.board_.capacity());
-    std::copy(other.board_.begin(), other.board_.end(),
-              std::back_inserter(this->board_));
-    this->actual_piece_ = std::make_unique<PieceState>(*other.actual_piece_);
-    this->next_piece_ = std::make_unique<PieceState>(*other.next_piece_);
-}
-
-Board& Board::operator=(const Board& other) {
-    Board tmp{other};
-    std::swap(this->pending_line_count_, tmp.pending_line_count_);
-    std::swap(this->cleared_line_count_, tmp.cleared_line_count_);
-    std::swap(this->lines_to_clear_, tmp.lines_to_clear_);
-    std::swap(this->board_, tmp.board_);
-    std::swap(this->actual_piece_, tmp.actual_piece_);
-    std::swap(this->next_piece_, tmp.next_piece_);
-    std::swap(this->points_, tmp.points_);
-    std::swap(this->level_, tmp.level_);
-    std::swap(this->start_level_, tmp.start_level_);
-    std::swap(this->game_phase_, tmp.game_phase_);
-    std::swap(this->next_drop_time_, tmp.next_drop_time_);
-    std::swap(this->time_duration_, tmp.time_duration_);
-    std::swap(this->highlight_end_time_, tmp.highlight_end_time_);
-    std::swap(this->start_time_, tmp.start_time_);
-    std::swap(this->current_time_, tmp.current_time_);
-
-    return *this;
-}
-
-void Board::SetStartLevel(size_t level) {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::BoardClean() {
+    this->Reset(NextBoardSeed(), this->start_level_);
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::Reset(uint32_t seed, size_t start_level) {
+    this->lines_to_clear_.fill(false);
+    this->pending_line_count_ = 0;
+    this->cleared_line_count_ = 0;
+    this->board_.fill(0);
+    this->row_masks_.fill(0);
+    this->locked_row_begin_ = this->kHeight_;
+    this->locked_row_end_ = 0;
+    this->points_ = 0;
+    this->level_ = 0;
+    this->start_level_ = start_level;
+    this->game_phase_ = GameState::kGameStartPhase;
+    this->next_drop_time_ = 0;
+    this->time_duration_ = 0;
+    this->highlight_end_time_ = 0;
+    this->frame_ = 0;
+    this->last_tick_index_ = 0;
+    this->next_drop_frame_ = 0;
+    this->entry_frame_ = 0;
+    this->line_clear_end_frame_ = 0;
+    this->lock_row_ = 0;
+    this->start_time_ = {};
+    this->current_time_ = {};
+    this->outgoing_lines_ = 0;
+    this->incoming_garbage_.Take();
+    this->Reseed(seed);
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::SetStartLevel(size_t level) {
     this->start_level_ = level;
 }
 
-void Board::StartGame() {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::StartGame() {
     this->SetNextGamePhase(GameState::kGameStartPhase);
 }
 
-void Board::PlayGame() {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::PlayGame() {
     this->SetNextGamePhase(GameState::kGamePlayPhase);
 }
 
-void Board::GameOver() {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::GameOver() {
     this->SetNextGamePhase(GameState::kGameOverPhase);
 }
 
-json Board::SaveToJson() {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::QueueGarbage(uint8_t lines) {
+    this->incoming_garbage_.Send(lines);
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+uint32_t Board<W, H>::TakeOutgoingLines() {
+    uint32_t lines = this->outgoing_lines_;
+    this->outgoing_lines_ = 0;
+    return lines;
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::SetAttackTable(const AttackTable& table) {
+    this->attack_table_ = table;
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+json Board<W, H>::SaveToJson() {
     json doc;
     doc["points"] = this->points_;
     doc["cleared lines"] = this->cleared_line_count_;
     doc["level"] = this->level_;
-    doc["board"] = this->board_;
+    std::array<std::array<uint8_t, W>, H> rows{};
+    for (int row = 0; row < this->kHeight_; ++row) {
+        std::copy_n(this->board_.begin() + row * this->kWidth_, this->kWidth_, rows[row].begin());
+    }
+    doc["board"] = rows;
     return doc;
 }
 
-bool Board::LoadFromJson(json obj) {
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+bool Board<W, H>::LoadFromJson(json obj) {
     if (obj.contains("board")) {
-        this->board_ = obj["board"].get<typeof(this->board_)>();
+        auto rows = obj["board"].get<std::vector<std::vector<uint8_t>>>();
+        if (rows.size() != this->kHeight_) {
+            return false;
+        }
+        for (int row = 0; row < this->kHeight_; ++row) {
+            if (rows[row].size() != this->kWidth_) {
+                return false;
+            }
+            for (int col = 0; col < this->kWidth_; ++col) {
+                this->SetValue(row, col, rows[row][col]);
+            }
+        }
+        // Check the whole loaded board on the next update.
+        this->lines_to_clear_.fill(false);
+        this->locked_row_begin_ = 0;
+        this->locked_row_end_ = this->kHeight_;
     }
     if (obj.contains("level")) {
         this->level_ = obj["level"].get<typeof(this->level_)>();
@@ -474,4 +840,48 @@ bool Board::LoadFromJson(json obj) {
     return true;
 }
 
-}
\ No newline at end of file
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+void Board<W, H>::BeginLoad() {}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+bool Board<W, H>::LoadValue(std::string_view key, uint64_t value) {
+    if (key == "level") {
+        this->level_ = value;
+    } else if (key == "points") {
+        this->points_ = value;
+    } else if (key == "cleared lines") {
+        this->cleared_line_count_ = value;
+    }
+    return true;
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+bool Board<W, H>::LoadCell(size_t row, size_t col, uint8_t value) {
+    if (row >= this->kHeight_ || col >= this->kWidth_) {
+        return false;
+    }
+    this->SetValue(static_cast<int>(row), static_cast<int>(col), value);
+    return true;
+}
+
+template <std::uint8_t W, std::uint8_t H>
+requires ValidBoardSize<W, H>
+bool Board<W, H>::EndLoad(size_t rows, size_t columns) {
+    if (rows == 0) {
+        return true;
+    }
+    if (rows != this->kHeight_ || columns != this->kWidth_) {
+        return false;
+    }
+    // Check the whole loaded board on the next update.
+    this->lines_to_clear_.fill(false);
+    this->locked_row_begin_ = 0;
+    this->locked_row_end_ = this->kHeight_;
+    return true;
+}
+
+}
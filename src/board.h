@@ -1,29 +1,49 @@
 #pragma once
 
+#include "garbage_mailbox.h"
+#include "kick_table.h"
+#include "piece_queue.h"
 #include "i_board.h"
 #include "i_save_service.h"
 
+#include <array>
 #include <cstdint>
 #include <chrono>
+#include <optional>
+#include <random>
+#include <span>
 
 namespace game {
 
-class Board : public IBoard, public ISaveService{
+template <std::uint8_t W, std::uint8_t H>
+concept ValidBoardSize = (W >= 4 && W <= 24 && H >= 4);
+
+template <std::uint8_t W, std::uint8_t H>
+class BoardProbe;
+
+// Playfield of W columns and H rows. The size is a template parameter so
+// every row loop has a constant trip count. Instantiated for 10x22
+// (standard), 16x22 (wide) and 10x40 (tall) in board.cpp. Boards of one
+// match are updated on different threads, so each starts on its own cache line.
+template <std::uint8_t W = 10, std::uint8_t H = 22>
+requires ValidBoardSize<W, H>
+class alignas(kCacheLineSize) Board : public IBoard, public ISaveService, public IStreamLoadable{
 public:
     Board();
-    Board(const Board& other);
-    Board& operator=(const Board& other);
-    std::shared_ptr<tetrino[]> GetPiece(const PieceType type) const override;
+    const tetrino* GetPiece(const PieceType type) const override;
     int GetShadowPieceRowPosition() override;
     int GetPieceRowPosition(const PieceType type) const override;
     int GetPieceColumnPosition(const PieceType type) const override;
     uint16_t GetPieceSize(const PieceType type) const override;
+    Shape GetPieceShape(const PieceType type) const override;
+    uint8_t GetPieceRotation(const PieceType type) const override;
     uint8_t GetBoardHeight() const override;
     uint8_t GetBoardWidth() const override;
-    std::vector<std::vector<uint8_t>> GetBoard() const override;
+    std::span<const uint8_t> GetBoard() const override;
     size_t GetClearedLineCount() const override;
     bool IsLineClearing(int index) const override;
-    GameState UpdateGame(MoveType input) override;
+    GameState UpdateGame(MoveType input, const FrameTime& frame_time) override;
+    bool CanShift(MoveType direction, const FrameTime& frame_time) const override;
     GameState GetActualGamePhase() const override;
     size_t GetStartLevel() const override;
     size_t GetLevel() const override;
@@ -32,29 +52,62 @@ public:
     void StartGame() override;
     void PlayGame() override;
     void GameOver() override;
+    void QueueGarbage(uint8_t lines) override;
+    uint32_t TakeOutgoingLines() override;
+    void SetAttackTable(const AttackTable& table) override;
+    void Reseed(uint32_t seed) override;
+    uint32_t GetSeed() const override;
+    void Reset(uint32_t seed, size_t start_level) override;
+    void SetPreviewDepth(size_t depth) override;
+    size_t GetPreviewDepth() const override;
+    Shape GetPreviewShape(size_t index) const override;
+    std::optional<Shape> GetHeldShape() const override;
+    void SetTimingModel(TimingModel timing) override;
+    TimingModel GetTimingModel() const override;
     json SaveToJson() override;
     bool LoadFromJson(json obj) override;
+    void BeginLoad() override;
+    bool LoadValue(std::string_view key, uint64_t value) override;
+    bool LoadCell(size_t row, size_t col, uint8_t value) override;
+    bool EndLoad(size_t rows, size_t columns) override;
 
 private:
+    template <std::uint8_t, std::uint8_t>
+    friend class BoardProbe;
+
     struct PieceState {
-        std::shared_ptr<Piece> piece;
-        int offset_row;
-        int offset_col;
+        Piece piece{Shape::kSquare};
+        int offset_row = 0;
+        int offset_col = 0;
     };
-    const uint8_t kFramesPerDrop[30]{
+    static constexpr uint8_t kFramesPerDrop[30]{
             48, 43, 38, 33, 28, 23, 18, 13, 8, 6,
             5, 5, 5, 4, 4, 4, 3, 3, 3, 2,
             2, 2, 2, 2, 2, 2, 2, 2, 2, 1
     };
-    const float kTargetSecondsPerFrame = 1.0f / 60.0f;
-    const uint8_t height_ = 22;
-    const uint8_t width_ = 10;
-    std::vector<bool> lines_to_clear_{};
+    static constexpr float kTargetSecondsPerFrame = 1.0f / 60.0f;
+    static constexpr uint8_t kHeight_ = H;
+    static constexpr uint8_t kWidth_ = W;
+    static constexpr uint32_t kFullRow_ = (1u << W) - 1;
+    // Wall columns on each side of a padded row mask in CheckPieceValid,
+    // wider than any kick from a valid position reaches.
+    static constexpr int kWallPadding_ = 8;
+    static constexpr uint64_t kWallMask_ = ~(static_cast<uint64_t>(kFullRow_) << kWallPadding_);
+    std::array<bool, H> lines_to_clear_{};
     uint8_t pending_line_count_ = 0;
     size_t cleared_line_count_ = 0;
-    std::vector<std::vector<uint8_t>> board_;
-    std::unique_ptr<PieceState> actual_piece_ = nullptr;
-    std::unique_ptr<PieceState> next_piece_ = nullptr;
+    std::array<uint8_t, W * H> board_{};
+    // Bit c of a row mask is set when column c is occupied.
+    std::array<uint32_t, H> row_masks_{};
+    // Rows written by MergePieceIntoBoard since the last FindLinesToClear.
+    int locked_row_begin_ = H;
+    int locked_row_end_ = 0;
+    PieceState actual_piece_{};
+    PieceQueue queue_{};
+    size_t preview_depth_ = 1;
+    std::optional<Shape> held_shape_;
+    // Set by a hold, cleared when the next piece spawns.
+    bool hold_used_ = false;
     size_t points_ = 0;
     size_t level_ = 0;
     size_t start_level_ = 0;
@@ -62,27 +115,49 @@ private:
     float next_drop_time_ = 0;
     float time_duration_ = 0;
     float highlight_end_time_ = 0;
+    // Frame counters of TimingModel::kNesFrames. frame_ counts the ticks the
+    // board was updated on since the game started, however long they took;
+    // several updates in one tick share its FrameTime::index and its frame.
+    TimingModel timing_ = TimingModel::kRealTime;
+    uint64_t frame_ = 0;
+    uint64_t last_tick_index_ = 0;
+    uint64_t next_drop_frame_ = 0;
+    // The piece spawned by the last lock takes input from this frame on.
+    uint64_t entry_frame_ = 0;
+    uint64_t line_clear_end_frame_ = 0;
+    // Lowest row of the last locked piece.
+    int lock_row_ = 0;
     std::chrono::time_point<std::chrono::steady_clock> start_time_{};
     std::chrono::time_point<std::chrono::steady_clock> current_time_{};
+    // Per board so boards can be updated concurrently.
+    uint32_t seed_;
+    std::minstd_rand rand_gen_;
+    AttackTable attack_table_ = kDefaultAttackTable;
+    uint32_t outgoing_lines_ = 0;
+    GarbageMailbox incoming_garbage_;
 
     void UpdateGameplay(const MoveType input);
     void UpdateGameStart();
     void UpdateGameOver();
     void UpdateGameLines();
     void MovePiece(const MoveType move);
-    void MovePieceLeft();
-    void MovePieceRight();
-    void RotatePiece();
+    // False when the piece is blocked and did not move.
+    bool MovePieceLeft();
+    bool MovePieceRight();
+    void RotatePiece(Turn turn);
+    void HoldPiece();
     void HardDrop();
     void SetNextDrop();
     bool SoftDrop();
     float GetTimeToNextDrop();
+    uint64_t GetFramesPerDrop() const;
     bool CheckRowFilled(const int& row) const;
     bool CheckRowEmpty(int row) const;
     int FindLinesToClear();
     void ClearLines();
     bool CheckPieceValid(const PieceState piece) const;
     void MergePieceIntoBoard();
+    void InsertGarbage();
     void MakePiece(int offset_row, int offset_col);
     Shape SelectRandomPiece();
     void SetValue(const int row, const int col, const uint8_t value);
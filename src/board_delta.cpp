@@ -0,0 +1,285 @@
+#include <algorithm>
+#include "board_delta.h"
+#include "varint.h"
+
+namespace game {
+
+namespace {
+
+enum DeltaFlags : uint8_t {
+    kKeyframe = 1 << 0,
+    kClearedRows = 1 << 1,
+    kChangedRows = 1 << 2,
+    kPieceMoved = 1 << 3,
+    kNextPiece = 1 << 4,
+    kScore = 1 << 5,
+    kPhase = 1 << 6,
+};
+
+// Row masks are a single varint, taller boards are always sent whole.
+constexpr int kMaxDeltaRows = 64;
+
+SpectatorState::PieceView CapturePiece(const IBoard& board, PieceType type) {
+    return SpectatorState::PieceView{board.GetPieceShape(type), board.GetPieceRotation(type),
+                                     board.GetPieceRowPosition(type), board.GetPieceColumnPosition(type)};
+}
+
+bool RowsEqual(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, int row, int width) {
+    return std::equal(a.begin() + row * width, a.begin() + (row + 1) * width, b.begin() + row * width);
+}
+
+bool IsRowFull(const std::vector<uint8_t>& cells, int row, int width) {
+    return std::none_of(cells.begin() + row * width, cells.begin() + (row + 1) * width, [](uint8_t value) {
+        return value == 0;
+    });
+}
+
+// Removes the rows in mask and drops everything above them, as ClearLines does.
+void ApplyClear(std::vector<uint8_t>& cells, int width, int height, uint64_t mask) {
+    int dest = height - 1;
+    for (int src = height - 1; src >= 0; --src) {
+        if (mask >> src & 1) {
+            continue;
+        }
+        if (dest != src) {
+            std::copy_n(cells.begin() + src * width, width, cells.begin() + dest * width);
+        }
+        --dest;
+    }
+    std::fill(cells.begin(), cells.begin() + (dest + 1) * width, 0);
+}
+
+// Cell values fit in a nibble, two cells per byte.
+void PutRow(std::vector<uint8_t>& out, const std::vector<uint8_t>& cells, int row, int width) {
+    const uint8_t* cell = cells.data() + row * width;
+    for (int col = 0; col < width; col += 2) {
+        uint8_t high = col + 1 < width ? cell[col + 1] : 0;
+        out.push_back(static_cast<uint8_t>((cell[col] & 0x0F) | (high << 4)));
+    }
+}
+
+bool GetRow(std::span<const uint8_t> in, size_t& offset, std::vector<uint8_t>& cells, int row, int width) {
+    size_t bytes = (width + 1) / 2;
+    if (offset + bytes > in.size()) {
+        return false;
+    }
+    uint8_t* cell = cells.data() + row * width;
+    for (int col = 0; col < width; col += 2) {
+        uint8_t packed = in[offset++];
+        cell[col] = packed & 0x0F;
+        if (col + 1 < width) {
+            cell[col + 1] = packed >> 4;
+        }
+    }
+    return true;
+}
+
+void PutPiece(std::vector<uint8_t>& out, const SpectatorState::PieceView& piece) {
+    out.push_back(static_cast<uint8_t>(static_cast<uint8_t>(piece.shape) << 2 | piece.rotation));
+    PutVarint(out, ZigZag(piece.row));
+    PutVarint(out, ZigZag(piece.col));
+}
+
+bool GetPiece(std::span<const uint8_t> in, size_t& offset, SpectatorState::PieceView& piece) {
+    uint64_t row = 0;
+    uint64_t col = 0;
+    if (offset >= in.size()) {
+        return false;
+    }
+    uint8_t packed = in[offset++];
+    if ((packed >> 2) >= kShapeCount || !GetVarint(in, offset, row) || !GetVarint(in, offset, col)) {
+        return false;
+    }
+    piece = SpectatorState::PieceView{static_cast<Shape>(packed >> 2), static_cast<uint8_t>(packed & 3),
+                                      static_cast<int>(UnZigZag(row)), static_cast<int>(UnZigZag(col))};
+    return true;
+}
+
+}
+
+void BoardDeltaEncoder::RequestKeyframe() {
+    this->keyframe_requested_ = true;
+}
+
+void BoardDeltaEncoder::Encode(const IBoard& board, uint32_t tick, std::vector<uint8_t>& out) {
+    auto& current = this->current_;
+    auto& previous = this->previous_;
+    auto cells = board.GetBoard();
+    current.tick = tick;
+    current.width = board.GetBoardWidth();
+    current.height = board.GetBoardHeight();
+    current.cells.assign(cells.begin(), cells.end());
+    current.actual_piece = CapturePiece(board, PieceType::kActualPiece);
+    current.next_piece = CapturePiece(board, PieceType::kNextPiece);
+    current.points = board.GetPoints();
+    current.cleared_lines = board.GetClearedLineCount();
+    current.level = board.GetLevel();
+    current.phase = board.GetActualGamePhase();
+
+    const int width = current.width;
+    const int height = current.height;
+    bool keyframe = !this->has_previous_ || this->keyframe_requested_ ||
+                    this->frames_since_keyframe_ + 1 >= kKeyframeInterval ||
+                    height > kMaxDeltaRows || previous.width != width || previous.height != height;
+
+    size_t flags_offset = out.size();
+    out.push_back(0);
+    PutVarint(out, tick);
+    uint8_t flags = 0;
+    if (keyframe) {
+        flags = kKeyframe | kChangedRows | kPieceMoved | kNextPiece | kScore | kPhase;
+        out.push_back(current.width);
+        out.push_back(current.height);
+        for (int row = 0; row < height; ++row) {
+            PutRow(out, current.cells, row, width);
+        }
+        this->frames_since_keyframe_ = 0;
+        this->keyframe_requested_ = false;
+    }
+    else {
+        ++this->frames_since_keyframe_;
+        // Full rows that are gone now were cleared; sending the clear is much
+        // smaller than every row that moved down because of it.
+        const std::vector<uint8_t>* base = &previous.cells;
+        uint64_t cleared_mask = 0;
+        for (int row = 0; row < height; ++row) {
+            if (IsRowFull(previous.cells, row, width) && !RowsEqual(previous.cells, current.cells, row, width)) {
+                cleared_mask |= uint64_t{1} << row;
+            }
+        }
+        if (cleared_mask != 0) {
+            this->cleared_ = previous.cells;
+            ApplyClear(this->cleared_, width, height, cleared_mask);
+            flags |= kClearedRows;
+            PutVarint(out, cleared_mask);
+            base = &this->cleared_;
+        }
+        uint64_t changed_mask = 0;
+        for (int row = 0; row < height; ++row) {
+            if (!RowsEqual(*base, current.cells, row, width)) {
+                changed_mask |= uint64_t{1} << row;
+            }
+        }
+        if (changed_mask != 0) {
+            flags |= kChangedRows;
+            PutVarint(out, changed_mask);
+            for (int row = 0; row < height; ++row) {
+                if (changed_mask >> row & 1) {
+                    PutRow(out, current.cells, row, width);
+                }
+            }
+        }
+        if (!(current.actual_piece == previous.actual_piece)) {
+            flags |= kPieceMoved;
+        }
+        if (!(current.next_piece == previous.next_piece)) {
+            flags |= kNextPiece;
+        }
+        if (current.points != previous.points || current.cleared_lines != previous.cleared_lines ||
+            current.level != previous.level) {
+            flags |= kScore;
+        }
+        if (current.phase != previous.phase) {
+            flags |= kPhase;
+        }
+    }
+
+    if (flags & kPieceMoved) {
+        PutPiece(out, current.actual_piece);
+    }
+    if (flags & kNextPiece) {
+        PutPiece(out, current.next_piece);
+    }
+    if (flags & kScore) {
+        PutVarint(out, current.points);
+        PutVarint(out, current.cleared_lines);
+        PutVarint(out, current.level);
+    }
+    if (flags & kPhase) {
+        out.push_back(static_cast<uint8_t>(current.phase));
+    }
+    out[flags_offset] = flags;
+
+    std::swap(this->previous_, this->current_);
+    this->has_previous_ = true;
+}
+
+bool BoardDeltaDecoder::Apply(std::span<const uint8_t> message) {
+    size_t offset = 0;
+    uint64_t tick = 0;
+    if (message.empty()) {
+        return false;
+    }
+    uint8_t flags = message[offset++];
+    if (!GetVarint(message, offset, tick)) {
+        return false;
+    }
+    if (!(flags & kKeyframe) && !this->has_state_) {
+        return false;
+    }
+
+    auto& state = this->state_;
+    state.tick = static_cast<uint32_t>(tick);
+    if (flags & kKeyframe) {
+        if (offset + 2 > message.size()) {
+            return false;
+        }
+        state.width = message[offset++];
+        state.height = message[offset++];
+        state.cells.assign(state.width * state.height, 0);
+        for (int row = 0; row < state.height; ++row) {
+            if (!GetRow(message, offset, state.cells, row, state.width)) {
+                return false;
+            }
+        }
+        this->has_state_ = true;
+    }
+    else {
+        uint64_t mask = 0;
+        if (flags & kClearedRows) {
+            if (!GetVarint(message, offset, mask)) {
+                return false;
+            }
+            ApplyClear(state.cells, state.width, state.height, mask);
+        }
+        if (flags & kChangedRows) {
+            if (!GetVarint(message, offset, mask)) {
+                return false;
+            }
+            for (int row = 0; row < state.height; ++row) {
+                if ((mask >> row & 1) && !GetRow(message, offset, state.cells, row, state.width)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    if ((flags & kPieceMoved) && !GetPiece(message, offset, state.actual_piece)) {
+        return false;
+    }
+    if ((flags & kNextPiece) && !GetPiece(message, offset, state.next_piece)) {
+        return false;
+    }
+    if ((flags & kScore) && !(GetVarint(message, offset, state.points) &&
+                              GetVarint(message, offset, state.cleared_lines) &&
+                              GetVarint(message, offset, state.level))) {
+        return false;
+    }
+    if (flags & kPhase) {
+        if (offset >= message.size()) {
+            return false;
+        }
+        state.phase = static_cast<GameState>(message[offset++]);
+    }
+    return offset == message.size();
+}
+
+bool BoardDeltaDecoder::HasState() const {
+    return this->has_state_;
+}
+
+const SpectatorState& BoardDeltaDecoder::GetState() const {
+    return this->state_;
+}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "i_board.h"
+
+namespace game {
+
+// What a spectator sees of one board.
+struct SpectatorState {
+    struct PieceView {
+        Shape shape = Shape::kSquare;
+        uint8_t rotation = 0;
+        int row = 0;
+        int col = 0;
+
+        bool operator==(const PieceView& other) const = default;
+    };
+
+    uint32_t tick = 0;
+    uint8_t width = 0;
+    uint8_t height = 0;
+    // Row-major, width cells per row.
+    std::vector<uint8_t> cells;
+    PieceView actual_piece;
+    PieceView next_piece;
+    uint64_t points = 0;
+    uint64_t cleared_lines = 0;
+    uint64_t level = 0;
+    GameState phase = GameState::kGameStartPhase;
+};
+
+// Encodes one board per tick as a binary delta against the previous tick:
+// changed rows, rows removed by a line clear, piece moves and score. A full
+// keyframe is sent first, every kKeyframeInterval ticks and on request so
+// spectators can join at any time.
+class BoardDeltaEncoder {
+public:
+    static constexpr uint32_t kKeyframeInterval = 300;
+
+    void Encode(const IBoard& board, uint32_t tick, std::vector<uint8_t>& out);
+    void RequestKeyframe();
+
+private:
+    SpectatorState previous_;
+    SpectatorState current_;
+    std::vector<uint8_t> cleared_;
+    bool has_previous_ = false;
+    bool keyframe_requested_ = false;
+    uint32_t frames_since_keyframe_ = 0;
+};
+
+// Rebuilds SpectatorState from the encoder's messages. Deltas are ignored
+// until the first keyframe arrives.
+class BoardDeltaDecoder {
+public:
+    // False on a malformed message or a delta without a keyframe before it.
+    bool Apply(std::span<const uint8_t> message);
+    bool HasState() const;
+    const SpectatorState& GetState() const;
+
+private:
+    SpectatorState state_;
+    std::vector<uint8_t> cleared_;
+    bool has_state_ = false;
+};
+
+}
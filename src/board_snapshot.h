@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "common.h"
+#include "piece_queue.h"
+#include "tetrino.h"
+
+namespace game {
+
+// Everything a Player draws, copied out of the board after each update so the
+// render thread never reads a board the simulation thread is writing.
+struct BoardSnapshot {
+    struct PieceView {
+        std::array<tetrino, kMaxTetrinoCells> cells{};
+        uint16_t size = 0;
+        int row = 0;
+        int col = 0;
+    };
+
+    // Row-major, width cells per row. Sized once, so later captures do not allocate.
+    std::vector<uint8_t> cells;
+    std::vector<uint8_t> clearing_rows;
+    PieceView actual_piece;
+    PieceView next_piece;
+    // Preview after the next piece, preview_count shapes.
+    std::array<Shape, PieceQueue::kMaxPreview - 1> preview{};
+    uint8_t preview_count = 0;
+    std::optional<Shape> held;
+    int shadow_row = 0;
+    uint8_t width = 0;
+    uint8_t height = 0;
+    size_t level = 0;
+    size_t points = 0;
+    size_t cleared_lines = 0;
+    GameState phase = GameState::kGameStartPhase;
+};
+
+}
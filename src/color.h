@@ -35,7 +35,8 @@ private:
                 {0x2D, 0x99, 0x51, 0xFF},
                 {0x99, 0x2D, 0x2D, 0xFF},
                 {0x2D, 0x63, 0x99, 0xFF},
-                {0x99, 0x63, 0x2D, 0xFF}
+                {0x99, 0x63, 0x2D, 0xFF},
+                {0x80, 0x80, 0x80, 0xFF}
         };
         static constexpr RGBA light_colors[] = {
                 {0x28, 0x28, 0x28, 0xFF},
@@ -45,7 +46,8 @@ private:
                 {0x44, 0xE5, 0x7A, 0xFF},
                 {0xE5, 0x44, 0x44, 0xFF},
                 {0x44, 0x95, 0xE5, 0xFF},
-                {0xE5, 0x95, 0x44, 0xFF}
+                {0xE5, 0x95, 0x44, 0xFF},
+                {0xB0, 0xB0, 0xB0, 0xFF}
         };
         static constexpr RGBA dark_colors[] = {
                 {0x28, 0x28, 0x28, 0xFF},
@@ -55,7 +57,8 @@ private:
                 {0x1E, 0x66, 0x36, 0xFF},
                 {0x66, 0x1E, 0x1E, 0xFF},
                 {0x1E, 0x42, 0x66, 0xFF},
-                {0x66, 0x42, 0x1E, 0xFF}
+                {0x66, 0x42, 0x1E, 0xFF},
+                {0x50, 0x50, 0x50, 0xFF}
         };
     };
 };
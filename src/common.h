@@ -1,11 +1,16 @@
 #pragma once
 
-#include <raylib.h>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 
 namespace game {
 
+// kUp rotates clockwise during play. kNone stays last, replays count moves
+// by it.
 enum class MoveType {
-    kLeft, kRight, kUp, kDown, kDrop, kConfirm, kPause, kLoad, kNone
+    kLeft, kRight, kUp, kDown, kDrop, kConfirm, kPause, kLoad, kRotateCcw, kRotate180, kHold, kLeftWall, kRightWall, kNone
 };
 
 enum class Shape {
@@ -16,6 +21,13 @@ enum class GameState {
     kGameStartPhase, kGamePlayPhase, kGameLinePhase, kGameOverPhase, kGamePause
 };
 
+// How a board measures time. kRealTime converts frame counts to seconds of
+// wall-clock time; kNesFrames counts whole 60 Hz frames in integers and adds
+// the NES entry and line-clear delays.
+enum class TimingModel {
+    kRealTime, kNesFrames
+};
+
 enum class TextAlignment {
     kRight, kCenter, kLeft
 };
@@ -33,7 +45,34 @@ struct PlayerMove {
     PlayerType player;
 };
 
-inline Color kBackgroundColor = BLACK;
-inline const char* font_type = "../src/fonts/novem___.ttf";
+// Garbage lines sent to opponents for clearing 0, 1, 2, 3 or 4 lines at once.
+using AttackTable = std::array<uint8_t, 5>;
+inline constexpr AttackTable kDefaultAttackTable{0, 0, 1, 2, 4};
+
+// State written by different threads is aligned to this to avoid false sharing.
+inline constexpr size_t kCacheLineSize = 64;
+
+// Sampled once per frame by the game loop and shared by every board updated
+// in that frame.
+struct FrameTime {
+    std::chrono::steady_clock::time_point now;
+    uint64_t index;
+};
+
+constexpr const char* GetGameStateName(GameState state) {
+    switch (state) {
+        case GameState::kGameStartPhase:
+            return "GameStartPhase";
+        case GameState::kGamePlayPhase:
+            return "GamePlayPhase";
+        case GameState::kGameLinePhase:
+            return "GameLinePhase";
+        case GameState::kGameOverPhase:
+            return "GameOverPhase";
+        case GameState::kGamePause:
+            return "GamePause";
+    }
+    return "";
+}
 
 }
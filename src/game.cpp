@@ -1,17 +1,18 @@
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
-#include <iostream>
-#include <filesystem>
+#include <ctime>
 #include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
 #include "game.h"
-#include "tinyfiledialogs.h"
+#include "save_loader.h"
+#include "profiler.h"
+#include "trace.h"
 
 namespace game {
 
-namespace fs = std::filesystem;
-
-template class Game<1>;
-template class Game<2>;
-
 void DrawString(Font font, float font_size, const char* msg, size_t x, size_t y,
                 TextAlignment alignment, Color color) {
     const int spacing = -2;
@@ -30,67 +31,15 @@ void DrawString(Font font, float font_size, const char* msg, size_t x, size_t y,
     }
     Vector2 position = {x_pos, y_pos};
     DrawTextEx(font, msg, position, font_size, spacing, color);
+    PROFILE_DRAW_CALLS(1);
 }
 
-std::string OpenFolderExplorer() {
-    const char* folderPath = tinyfd_selectFolderDialog("Select a folder", "");
-    if (folderPath) {
-        return {folderPath};
-    }
-
-    return "";
-}
-
-std::string OpenFileExplorer() {
-    const char* filePath = tinyfd_openFileDialog("Select a file", "", 0,
-                                                 nullptr, nullptr, 0);
-    if (filePath) {
-        return {filePath};
-    }
-
-    return "";
-}
-
-std::string GenerateSaveFileName(const std::string& directoryPath) {
-    int fileNumber = 1;
-    std::string baseName = "tetris_save_";
-    std::string extension = ".json";
-    std::ostringstream fileName;
-
-    do {
-        fileName.str("");
-        fileName << baseName << std::setw(2) << std::setfill('0') << fileNumber << extension;
-        ++fileNumber;
-    } while (fs::exists(fs::path(directoryPath) / fileName.str()));
-
-    return (fs::path(directoryPath) / fileName.str()).string();
-}
-
-bool CreateSaveFile(const std::string& directoryPath, const json &data) {
-    std::string saveFileName = GenerateSaveFileName(directoryPath);
-
-    std::ofstream ofs(saveFileName);
-    if (!ofs) {
-        std::cerr << "Failed to create file: " << saveFileName << std::endl;
-        return false;
-    }
-
-    ofs << data;
-    ofs.close();
-
-    std::cout << "File created: " << saveFileName << std::endl;
-    return true;
-}
-
-std::string ReadFileContents(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open file");
-    }
-
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
+void WriteTraceFile() {
+#ifdef TETRIS_TRACE
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    trace::Flush("tetris_trace_" + std::to_string(seconds) + ".json");
+#endif
 }
 
 void DrawMessageBox(const char* message, int x_pos, int y_pos) {
@@ -116,98 +65,470 @@ void DrawMessageBox(const char* message, int x_pos, int y_pos) {
     }
 }
 
-template <std::uint8_t N>
-requires ValidPlayerCount<N>
-Game<N>::~Game() {
+void DrawProfilerOverlay(Font font) {
+    const int x = 10;
+    const int width = 380;
+    const int spacing = 18;
+    const int graph_height = 60;
+    const float font_size = font.baseSize * 0.6f;
+    const float frame_budget_ms = 1000.0f / 60.0f;
+    int y = 10;
+
+    DrawRectangle(x - 5, y - 5, width + 10, (4 + (int)profiler::kZoneCount) * spacing + graph_height + 15,
+                  Color{0, 0, 0, 200});
+    if (profiler::GetFrameCount() == 0) {
+        game::DrawString(font, font_size, "PROFILER DISABLED", x, y, TextAlignment::kLeft, WHITE);
+        return;
+    }
+
+    char buffer[128];
+    const auto& frame = profiler::GetFrame(0);
+    std::sprintf(buffer, "FRAME: %.2f MS (%d FPS)", frame.frame_ns / 1e6, GetFPS());
+    game::DrawString(font, font_size, buffer, x, y, TextAlignment::kLeft, WHITE);
+    y += spacing;
+    for (size_t i = 0; i < profiler::kZoneCount; ++i) {
+        if (frame.slowest_player[i] != profiler::kNoPlayer) {
+            std::sprintf(buffer, "%s: %.3f MS  x%u  MAX P%zu %.3f MS",
+                         profiler::GetZoneName(static_cast<profiler::Zone>(i)), frame.zone_ns[i] / 1e6,
+                         frame.zone_calls[i], frame.slowest_player[i] + 1, frame.slowest_player_ns[i] / 1e6);
+        } else {
+            std::sprintf(buffer, "%s: %.3f MS  x%u", profiler::GetZoneName(static_cast<profiler::Zone>(i)),
+                         frame.zone_ns[i] / 1e6, frame.zone_calls[i]);
+        }
+        game::DrawString(font, font_size, buffer, x, y, TextAlignment::kLeft, LIGHTGRAY);
+        y += spacing;
+    }
+    std::sprintf(buffer, "DRAW CALLS: %u", frame.draw_calls);
+    game::DrawString(font, font_size, buffer, x, y, TextAlignment::kLeft, WHITE);
+    y += spacing;
+    std::sprintf(buffer, "ALLOCATIONS: %zu", frame.allocations);
+    game::DrawString(font, font_size, buffer, x, y, TextAlignment::kLeft, WHITE);
+    y += spacing + 5;
+
+    // Rolling graph, newest frame on the right. The full height is two frame budgets.
+    const int graph_bottom = y + graph_height;
+    const size_t sim_zone = static_cast<size_t>(profiler::Zone::kSimulation);
+    size_t count = std::min(profiler::GetFrameCount(), static_cast<size_t>(width));
+    for (size_t age = 0; age < count; ++age) {
+        const auto& past = profiler::GetFrame(age);
+        float frame_ms = past.frame_ns / 1e6f;
+        float sim_ms = past.zone_ns[sim_zone] / 1e6f;
+        int frame_h = std::min(graph_height, (int)(frame_ms / (2 * frame_budget_ms) * graph_height));
+        int sim_h = std::min(frame_h, (int)(sim_ms / (2 * frame_budget_ms) * graph_height));
+        int bar_x = x + width - 1 - (int)age;
+        DrawLine(bar_x, graph_bottom, bar_x, graph_bottom - frame_h, frame_ms > frame_budget_ms ? RED : GREEN);
+        DrawLine(bar_x, graph_bottom, bar_x, graph_bottom - sim_h, SKYBLUE);
+    }
+    DrawLine(x, graph_bottom - graph_height / 2, x + width, graph_bottom - graph_height / 2, YELLOW);
+}
+
+size_t GetWorkerCount(size_t player_count, size_t min_players_per_worker) {
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    return std::clamp<size_t>(player_count / min_players_per_worker, 1, hardware);
+}
+
+Game::Game(const size_t screen_height, const size_t screen_width, const char* font,
+           std::vector<IPlayer*> players)
+    : kScreenHeight_(screen_height),
+      kScreenWidth_(screen_width),
+      players_(std::move(players)),
+      slots_(this->players_.size()),
+      pool_(GetWorkerCount(this->players_.size(), kMinPlayersPerWorker_)),
+      font_type_(font),
+      replays_(this->players_.size()) {
+    if (this->players_.empty()) {
+        throw std::invalid_argument("Game needs at least one player");
+    }
+}
+
+Game::~Game() {
+    this->StopSimulation();
+    this->SaveReplays();
+    WriteTraceFile();
     UnloadFont(this->font_);
     CloseWindow();
 }
 
-template <std::uint8_t N>
-requires ValidPlayerCount<N>
-void Game<N>::InitRenderer() {
+void Game::InitRenderer() {
+    TRACE_THREAD_NAME("main");
     InitWindow(this->kScreenWidth_, this->kScreenHeight_, this->kTitle_);
     this->font_ = LoadFont(font_type_);
     for (auto &player : players_) {
         player->SetFont(this->font_);
     }
+    this->LayoutPlayers();
     SetTargetFPS(60);
 }
 
-template <std::uint8_t N>
-requires ValidPlayerCount<N>
-void Game<N>::GameLoop() {
+void Game::LayoutPlayers() {
+    // All players share the first player's native size; pick the column count
+    // that lets the grid fill the window at the largest scale, never upscaling.
+    const Vector2 size = this->players_.front()->GetLayoutSize();
+    const size_t count = this->players_.size();
+    size_t best_columns = 1;
+    float best_scale = 0.0f;
+    for (size_t columns = 1; columns <= count; ++columns) {
+        size_t rows = (count + columns - 1) / columns;
+        float scale = std::min({1.0f, this->kScreenWidth_ / (columns * size.x),
+                                this->kScreenHeight_ / (rows * size.y)});
+        if (scale > best_scale) {
+            best_scale = scale;
+            best_columns = columns;
+        }
+    }
+
+    const float cell_width = size.x * best_scale;
+    const float cell_height = size.y * best_scale;
+    const float x_origin = (this->kScreenWidth_ - best_columns * cell_width) / 2.0f;
+    for (size_t i = 0; i < count; ++i) {
+        int x = static_cast<int>(x_origin + (i % best_columns) * cell_width);
+        int y = static_cast<int>((i / best_columns) * cell_height);
+        this->players_[i]->SetLayout(x, y, best_scale);
+    }
+}
+
+void Game::GameLoop() {
     while (!WindowShouldClose()) {
+        TRACE_SCOPE("Frame");
+        this->frame_time_ = FrameTime{std::chrono::steady_clock::now(), this->frame_time_.index + 1};
         PlayerMove input{};
         try {
+            PROFILE_ZONE(profiler::Zone::kInput);
             input = this->GetMoveType().value();
         }
         catch (std::bad_optional_access& e) {
             input = PlayerMove{MoveType::kNone, PlayerType::kPlayerNone};
         }
 
-        switch (this->game_phase_) {
-            case GameState::kGameStartPhase:
-                this->UpdateGameStart(input.moveType);
-                this->DrawStartScreen();
+        if (IsKeyPressed(KEY_F3)) {
+            this->show_profiler_ = !this->show_profiler_;
+        }
+        if (IsKeyPressed(KEY_F4)) {
+            WriteTraceFile();
+        }
+
+        auto previous_phase = this->game_phase_;
+        this->UpdateGame(input);
+        if (this->game_phase_ != previous_phase) {
+            TRACE_INSTANT(GetGameStateName(this->game_phase_), 1);
+        }
+        this->RenderGame();
+        PROFILE_FRAME_END();
+    }
+}
+
+void Game::UpdateGame(const PlayerMove input) {
+    switch (this->game_phase_) {
+        case GameState::kGameStartPhase:
+            if (this->browsing_saves_) {
+                this->UpdateLoadBrowser(input.moveType);
+                this->DrawLoadBrowser();
                 break;
+            }
+            this->UpdateGameStart(input.moveType);
+            this->DrawStartScreen();
+            break;
+
+        case GameState::kGameOverPhase: {
+            this->UpdateGameOver(input.moveType);
+            size_t x = this->kScreenWidth_ / 2;
+            size_t y = this->kScreenHeight_ / 2 - 80;
+            game::DrawString(this->font_, this->font_.baseSize * 2.5,
+                             "GAME OVER", x, y, TextAlignment::kCenter,
+                             WHITE);
+            break;
+        }
 
-            case GameState::kGameOverPhase: {
-                this->UpdateGameOver(input.moveType);
-                size_t x = this->kScreenWidth_ / 2;
-                size_t y = this->kScreenHeight_ / 2 - 80;
-                game::DrawString(this->font_, this->font_.baseSize * 2.5,
-                                 "GAME OVER", x, y, TextAlignment::kCenter,
-                                 WHITE);
+        case GameState::kGamePlayPhase:
+        case GameState::kGameLinePhase:
+            if (this->simulation_game_over_.load(std::memory_order_acquire)) {
+                this->StopSimulation();
+                this->SaveReplays();
+                this->game_phase_ = GameState::kGameOverPhase;
+                break;
+            }
+            if (input.moveType == MoveType::kPause) {
+                this->StopSimulation();
+                this->game_phase_ = GameState::kGamePause;
                 break;
             }
+            // A full queue means the simulation is stalled, the move is dropped.
+            if (input.player != PlayerType::kPlayerNone) {
+                this->input_queue_.Push(InputEvent{input, InputEvent::Kind::kMove, this->frame_time_.now});
+            }
+            this->PollShiftKeys();
+            break;
 
-            case GameState::kGamePlayPhase:
-            case GameState::kGameLinePhase:
-                switch (input.player) {
-                    case PlayerType::kPlayer1:
-                        this->game_phase_ = this->players_.at(0)->UpdatePlayer(input.moveType);
-                        break;
-                    case PlayerType::kPlayer2:
-                        this->game_phase_ = this->players_.at(1)->UpdatePlayer(input.moveType);
-                        break;
-                    case PlayerType::kPlayerNone:
-                        for (const auto &player : this->players_) {
-                            this->game_phase_ = player->UpdatePlayer(input.moveType);
-                            if (this->game_phase_ == GameState::kGameOverPhase)
-                                break;
-                        }
-                        break;
-                }
+        case GameState::kGamePause:
+            this->PauseGame();
+            break;
+    }
+}
+
+GameState Game::UpdateAllPlayers(const MoveType input, const FrameTime& frame_time) {
+    auto update = [this, input, &frame_time](size_t index) {
+        this->slots_[index].phase = this->UpdatePlayer(index, input, frame_time);
+        this->SendGarbage(index);
+    };
+    this->pool_.Run(this->players_.size(), update);
+
+    // The match is over as soon as one board tops out.
+    for (const auto& slot : this->slots_) {
+        if (slot.phase == GameState::kGameOverPhase) {
+            return GameState::kGameOverPhase;
+        }
+    }
+    return this->slots_.back().phase;
+}
+
+// Timed per player, so the overlay can name the slowest board.
+GameState Game::UpdatePlayer(size_t index, MoveType input, const FrameTime& frame_time) {
+    PROFILE_PLAYER_ZONE(profiler::Zone::kBoardUpdate, index);
+    return this->players_[index]->UpdatePlayer(input, frame_time);
+}
+
+void Game::SendGarbage(size_t index) {
+    uint32_t lines = this->players_[index]->TakeOutgoingLines();
+    const size_t opponents = this->players_.size() - 1;
+    if (lines == 0 || opponents == 0) {
+        return;
+    }
+    auto& slot = this->slots_[index];
+    size_t target = (index + 1 + slot.next_target) % this->players_.size();
+    slot.next_target = (slot.next_target + 1) % opponents;
+    this->players_[target]->QueueGarbage(static_cast<uint8_t>(std::min<uint32_t>(lines, UINT8_MAX)));
+}
+
+void Game::SetReplayDirectory(std::filesystem::path directory) {
+    this->replay_directory_ = std::move(directory);
+}
+
+void Game::StartRecording() {
+    if (this->replay_directory_.empty()) {
+        return;
+    }
+    for (size_t i = 0; i < this->players_.size(); ++i) {
+        this->players_[i]->StartRecording(this->replays_[i], this->frame_time_);
+    }
+}
+
+void Game::SaveReplays() {
+    std::error_code error;
+    auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    for (size_t i = 0; i < this->players_.size(); ++i) {
+        if (!this->replays_[i].IsRecording()) {
+            continue;
+        }
+        this->players_[i]->StopRecording();
+        std::vector<uint8_t> replay = this->replays_[i].Finish();
+        std::filesystem::create_directories(this->replay_directory_, error);
+        auto path = this->replay_directory_ /
+                    ("replay-" + std::to_string(milliseconds) + "-" + std::to_string(i) + ".replay");
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(replay.data()), static_cast<std::streamsize>(replay.size()));
+        if (!file) {
+            std::cerr << "Failed to write replay: " << path << std::endl;
+        }
+    }
+}
+
+void Game::StartSimulation() {
+    this->simulation_game_over_.store(false, std::memory_order_relaxed);
+    // Keys released while the simulation was stopped were never seen.
+    for (auto& shift : this->auto_shift_) {
+        shift.Reset();
+    }
+    {
+        std::lock_guard lock(this->simulation_mutex_);
+        this->simulation_tick_ = this->frame_time_;
+        this->simulation_running_.store(true, std::memory_order_release);
+    }
+    if (!this->simulation_.joinable()) {
+        this->simulation_ = std::jthread([this](std::stop_token stop) {
+            this->SimulationThread(stop);
+        });
+        return;
+    }
+    this->simulation_wake_.notify_one();
+}
+
+void Game::StopSimulation() {
+    {
+        std::unique_lock lock(this->simulation_mutex_);
+        this->simulation_running_.store(false, std::memory_order_release);
+        this->simulation_wake_.wait(lock, [this] { return !this->simulation_active_; });
+        this->frame_time_.index = std::max(this->frame_time_.index, this->simulation_tick_.index);
+    }
+    // The thread is parked, moves it did not take are stale.
+    InputEvent stale{};
+    while (this->input_queue_.Pop(stale)) {
+    }
+}
+
+void Game::SimulationThread(std::stop_token stop) {
+    TRACE_THREAD_NAME("simulation");
+    std::unique_lock lock(this->simulation_mutex_);
+    while (this->simulation_wake_.wait(lock, stop, [this] {
+        return this->simulation_running_.load(std::memory_order_relaxed);
+    })) {
+        this->simulation_active_ = true;
+        FrameTime tick = this->simulation_tick_;
+        lock.unlock();
+        this->SimulationLoop(tick);
+        lock.lock();
+        this->simulation_tick_ = tick;
+        this->simulation_running_.store(false, std::memory_order_relaxed);
+        this->simulation_active_ = false;
+        this->simulation_wake_.notify_all();
+    }
+}
+
+void Game::SimulationLoop(FrameTime& tick) {
+    using Clock = std::chrono::steady_clock;
+    const auto tick_duration = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / kTicksPerSecond_));
+    auto next_tick = Clock::now();
+
+    while (this->simulation_running_.load(std::memory_order_acquire)) {
+        // Stamped with the scheduled time, so a steady run has exactly
+        // equal intervals and replays store them in a bit or two.
+        tick = FrameTime{next_tick, tick.index + 1};
+        if (this->SimulationTick(tick) == GameState::kGameOverPhase) {
+            this->simulation_game_over_.store(true, std::memory_order_release);
+            return;
+        }
 
-                if (input.moveType == MoveType::kPause) {
-                    this->game_phase_ = GameState::kGamePause;
+        // Fixed rate; after a stall resume from now instead of catching up.
+        next_tick += tick_duration;
+        auto now = Clock::now();
+        if (next_tick < now) {
+            next_tick = now;
+        }
+        std::this_thread::sleep_until(next_tick);
+    }
+}
+
+// Applies queued input, then due shifts, then steps every board. Stops at
+// the first update that tops a board out, so its game over phase is not
+// stepped past by a later update in the same tick.
+GameState Game::SimulationTick(const FrameTime& tick) {
+    TRACE_SCOPE("Tick");
+    PROFILE_ZONE(profiler::Zone::kSimulation);
+    InputEvent event{};
+    while (this->input_queue_.Pop(event)) {
+        size_t index = event.move.player == PlayerType::kPlayer1 ? 0 : 1;
+        if (index >= this->players_.size()) {
+            continue;
+        }
+        // Shifts due before the event happen before it. The event carries its
+        // own press time and the index of the tick that took it.
+        const FrameTime stamp{event.time, tick.index};
+        if (this->ApplyShifts(index, stamp, tick) == GameState::kGameOverPhase) {
+            return GameState::kGameOverPhase;
+        }
+        switch (event.kind) {
+            case InputEvent::Kind::kMove:
+                if (this->UpdatePlayer(index, event.move.moveType, tick) == GameState::kGameOverPhase) {
+                    return GameState::kGameOverPhase;
                 }
                 break;
-
-            case GameState::kGamePause:
-                this->PauseGame();
+            case InputEvent::Kind::kPress:
+                this->auto_shift_[index].Press(event.move.moveType, stamp);
+                break;
+            case InputEvent::Kind::kRelease:
+                this->auto_shift_[index].Release(event.move.moveType, stamp);
                 break;
         }
+    }
+    for (size_t i = 0; i < this->auto_shift_.size() && i < this->players_.size(); ++i) {
+        if (this->ApplyShifts(i, tick, tick) == GameState::kGameOverPhase) {
+            return GameState::kGameOverPhase;
+        }
+    }
+    return this->UpdateAllPlayers(MoveType::kNone, tick);
+}
 
-        this->RenderGame();
+// Every shift due up to until is a separate move, several may fall into one
+// tick. A shift to the wall is a single move however far the piece goes, and
+// only made when the piece can move at all: a held key stays due to the wall,
+// but once the piece is there nothing is updated or recorded until a new
+// piece comes into play or the direction changes.
+GameState Game::ApplyShifts(size_t index, const FrameTime& until, const FrameTime& tick) {
+    auto& shift = this->auto_shift_[index];
+    uint32_t shifts = shift.Advance(until);
+    if (shifts == AutoShift::kToWall) {
+        if (!this->players_[index]->CanShift(shift.GetDirection(), tick)) {
+            return GameState::kGamePlayPhase;
+        }
+        MoveType wall = shift.GetDirection() == MoveType::kLeft ? MoveType::kLeftWall : MoveType::kRightWall;
+        return this->UpdatePlayer(index, wall, tick);
     }
+    GameState phase = GameState::kGamePlayPhase;
+    for (; shifts > 0 && phase != GameState::kGameOverPhase; --shifts) {
+        phase = this->UpdatePlayer(index, shift.GetDirection(), tick);
+    }
+    return phase;
 }
 
-template <std::uint8_t N>
-requires ValidPlayerCount<N>
-void Game<N>::RenderGame() const {
-    BeginDrawing();
-    ClearBackground(game::kBackgroundColor);
-    for (const auto& player : players_) {
-        player->DrawPlayer();
+void Game::SetAutoShift(AutoShiftSettings settings) {
+    for (auto& shift : this->auto_shift_) {
+        shift.SetSettings(settings);
     }
+}
+
+void Game::SetAutoShift(AutoShiftFrames frames) {
+    for (auto& shift : this->auto_shift_) {
+        shift.SetSettings(frames);
+    }
+}
+
+// Held directions are tracked as press and release edges, the simulation
+// thread turns them into shifts.
+void Game::PollShiftKeys() {
+    struct ShiftKey {
+        int key;
+        MoveType direction;
+        PlayerType player;
+    };
+    static constexpr ShiftKey kShiftKeys[]{
+            {KEY_A, MoveType::kLeft, PlayerType::kPlayer1},
+            {KEY_D, MoveType::kRight, PlayerType::kPlayer1},
+            {KEY_LEFT, MoveType::kLeft, PlayerType::kPlayer2},
+            {KEY_RIGHT, MoveType::kRight, PlayerType::kPlayer2},
+    };
+    for (const auto& shift_key : kShiftKeys) {
+        if (shift_key.player == PlayerType::kPlayer2 && this->players_.size() < 2) {
+            break;
+        }
+        PlayerMove move{shift_key.direction, shift_key.player};
+        if (IsKeyPressed(shift_key.key)) {
+            this->input_queue_.Push(InputEvent{move, InputEvent::Kind::kPress, this->frame_time_.now});
+        }
+        if (IsKeyReleased(shift_key.key)) {
+            this->input_queue_.Push(InputEvent{move, InputEvent::Kind::kRelease, this->frame_time_.now});
+        }
+    }
+}
+
+void Game::RenderGame() const {
+    {
+        PROFILE_ZONE(profiler::Zone::kRender);
+        BeginDrawing();
+        ClearBackground(game::kBackgroundColor);
+        for (size_t i = 0; i < this->players_.size(); ++i) {
+            PROFILE_PLAYER_ZONE(profiler::Zone::kPlayerDraw, i);
+            this->players_[i]->DrawPlayer();
+        }
+        if (this->show_profiler_) {
+            DrawProfilerOverlay(this->font_);
+        }
+    }
+    PROFILE_ZONE(profiler::Zone::kPresent);
     EndDrawing();
 }
 
-template <std::uint8_t N>
-requires ValidPlayerCount<N>
-std::optional<PlayerMove> Game<N>::GetMoveType() const {
+std::optional<PlayerMove> Game::GetMoveType() const {
     if (IsKeyPressed(KEY_ENTER))
         return PlayerMove{MoveType::kConfirm, PlayerType::kPlayer1};
     if (IsKeyPressed(KEY_P))
@@ -215,24 +536,28 @@ std::optional<PlayerMove> Game<N>::GetMoveType() const {
     if (IsKeyPressed(KEY_SPACE))
         return PlayerMove{MoveType::kLoad, PlayerType::kPlayer1};
 
-    if (IsKeyPressed(KEY_A))
-        return PlayerMove{MoveType::kLeft, PlayerType::kPlayer1};
-    if (IsKeyPressed(KEY_D))
-        return PlayerMove{MoveType::kRight, PlayerType::kPlayer1};
     if (IsKeyPressed(KEY_W))
         return PlayerMove{MoveType::kUp, PlayerType::kPlayer1};
+    if (IsKeyPressed(KEY_Q))
+        return PlayerMove{MoveType::kRotateCcw, PlayerType::kPlayer1};
+    if (IsKeyPressed(KEY_E))
+        return PlayerMove{MoveType::kRotate180, PlayerType::kPlayer1};
+    if (IsKeyPressed(KEY_C))
+        return PlayerMove{MoveType::kHold, PlayerType::kPlayer1};
     if (IsKeyPressed(KEY_S))
         return PlayerMove{MoveType::kDown, PlayerType::kPlayer1};
     if (IsKeyPressed(KEY_LEFT_CONTROL))
         return PlayerMove{MoveType::kDrop, PlayerType::kPlayer1};
 
-    if (N == 2) {
-        if (IsKeyPressed(KEY_LEFT))
-            return PlayerMove{MoveType::kLeft, PlayerType::kPlayer2};
-        if (IsKeyPressed(KEY_RIGHT))
-            return PlayerMove{MoveType::kRight, PlayerType::kPlayer2};
+    if (this->players_.size() >= 2) {
         if (IsKeyPressed(KEY_UP))
             return PlayerMove{MoveType::kUp, PlayerType::kPlayer2};
+        if (IsKeyPressed(KEY_RIGHT_SHIFT))
+            return PlayerMove{MoveType::kRotateCcw, PlayerType::kPlayer2};
+        if (IsKeyPressed(KEY_RIGHT_ALT))
+            return PlayerMove{MoveType::kRotate180, PlayerType::kPlayer2};
+        if (IsKeyPressed(KEY_SLASH))
+            return PlayerMove{MoveType::kHold, PlayerType::kPlayer2};
         if (IsKeyPressed(KEY_DOWN))
             return PlayerMove{MoveType::kDown, PlayerType::kPlayer2};
         if (IsKeyPressed(KEY_RIGHT_CONTROL))
@@ -242,9 +567,7 @@ std::optional<PlayerMove> Game<N>::GetMoveType() const {
     return std::nullopt;
 }
 
-template <std::uint8_t N>
-requires ValidPlayerCount<N>
-void Game<N>::UpdateGameStart(const MoveType input) {
+void Game::UpdateGameStart(const MoveType input) {
     if (input == MoveType::kUp) {
         ++this->start_level_;
     }
@@ -255,30 +578,114 @@ void Game<N>::UpdateGameStart(const MoveType input) {
         for (auto& player : players_) {
             player->SetStartLevel(this->start_level_);
         }
+        this->StartRecording();
         this->game_phase_ = GameState::kGamePlayPhase;
         for (const auto &player : players_) {
             player->StartGame();
-            player->UpdatePlayer(MoveType::kNone);
+            player->UpdatePlayer(MoveType::kNone, this->frame_time_);
             player->PlayGame();
         }
+        this->StartSimulation();
     }
     if (input == MoveType::kLoad) {
+        this->OpenLoadBrowser();
+    }
+}
+
+void Game::OpenLoadBrowser() {
+    if (!this->saves_.Open()) {
+        DrawMessageBox("Loading error!", this->kScreenWidth_ / 2, this->kScreenHeight_ / 2);
+        return;
+    }
+    if (this->saves_.GetEntries().empty()) {
+        DrawMessageBox("No saved games", this->kScreenWidth_ / 2, this->kScreenHeight_ / 2);
+        return;
+    }
+    this->browsing_saves_ = true;
+    this->selected_save_ = 0;
+}
+
+void Game::UpdateLoadBrowser(const MoveType input) {
+    // Listed newest first, selected_save_ counts from the newest entry.
+    const auto& entries = this->saves_.GetEntries();
+    if (input == MoveType::kUp && this->selected_save_ > 0) {
+        --this->selected_save_;
+    }
+    if (input == MoveType::kDown && this->selected_save_ + 1 < entries.size()) {
+        ++this->selected_save_;
+    }
+    if (input == MoveType::kLoad || input == MoveType::kPause) {
+        this->browsing_saves_ = false;
+    }
+    if (input == MoveType::kConfirm) {
+        this->browsing_saves_ = false;
         for (const auto &player : players_) {
             player->StartGame();
-            player->UpdatePlayer(MoveType::kNone);
+            player->UpdatePlayer(MoveType::kNone, this->frame_time_);
         }
-        if (this->LoadFromJson({})) {
+        if (this->LoadSave(entries[entries.size() - 1 - this->selected_save_])) {
             this->game_phase_ = GameState::kGamePlayPhase;
             for (const auto &player : players_) {
                 player->PlayGame();
             }
+            this->StartSimulation();
+        } else {
+            DrawMessageBox("Loading error!", this->kScreenWidth_ / 2, this->kScreenHeight_ / 2);
+        }
+    }
+}
+
+void Game::DrawLoadBrowser() const {
+    const size_t kVisibleRows = 12;
+    const auto& entries = this->saves_.GetEntries();
+    float x = this->kScreenWidth_ / 2.0f;
+    float y = this->kScreenHeight_ / 2.0f - 250.0f;
+    float spacing = 30;
+    game::DrawString(this->font_, this->font_.baseSize * 1.5, "LOAD GAME", x, y, TextAlignment::kCenter, WHITE);
+    y += 2 * spacing;
+
+    // Scroll so the selection stays in view.
+    size_t first = this->selected_save_ < kVisibleRows ? 0 : this->selected_save_ - kVisibleRows + 1;
+    size_t last = std::min(entries.size(), first + kVisibleRows);
+    char date[32];
+    char buffer[128];
+    for (size_t row = first; row < last; ++row) {
+        const auto& entry = entries[entries.size() - 1 - row];
+        std::time_t timestamp = static_cast<std::time_t>(entry.timestamp);
+        // The index can be edited or corrupt, localtime fails for years it cannot represent.
+        const std::tm* local = std::localtime(&timestamp);
+        if (local == nullptr || std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M", local) == 0) {
+            std::snprintf(date, sizeof(date), "----");
         }
+        std::sprintf(buffer, "#%llu  %s  PLAYERS %u  LEVEL %llu  POINTS %llu",
+                     static_cast<unsigned long long>(entry.id), date, entry.players,
+                     static_cast<unsigned long long>(entry.level), static_cast<unsigned long long>(entry.points));
+        game::DrawString(this->font_, this->font_.baseSize, buffer, x, y, TextAlignment::kCenter,
+                         row == this->selected_save_ ? YELLOW : LIGHTGRAY);
+        y += spacing;
+    }
+    y += spacing;
+    game::DrawString(this->font_, this->font_.baseSize, "SELECT: UP / DOWN    LOAD: ENTER    BACK: SPACE BAR",
+                     x, y, TextAlignment::kCenter, WHITE);
+}
+
+bool Game::LoadSave(const SaveEntry& entry) {
+    TRACE_SCOPE("LoadGame");
+    std::ifstream archive;
+    if (!this->saves_.OpenDocument(entry, archive)) {
+        return false;
+    }
+    // Boards are filled straight from the archive, the save is never held in
+    // memory as a whole.
+    std::vector<IStreamLoadable*> loaders;
+    loaders.reserve(this->players_.size());
+    for (auto player : this->players_) {
+        loaders.push_back(dynamic_cast<IStreamLoadable*>(player));
     }
+    return StreamSaveDocument(archive, loaders);
 }
 
-template <std::uint8_t N>
-requires ValidPlayerCount<N>
-void Game<N>::DrawStartScreen() const {
+void Game::DrawStartScreen() const {
     char buffer[2048];
     std::sprintf(buffer, "START LEVEL: %ld", this->start_level_);
     float x = this->kScreenWidth_ / 2.0f;
@@ -298,6 +705,8 @@ void Game<N>::DrawStartScreen() const {
     game::DrawString(this->font_, this->font_.baseSize, "PAUSE/SAVE GAME:      P", x, y, TextAlignment::kCenter, WHITE);
     y += spacing;
     game::DrawString(this->font_, this->font_.baseSize, "LOAD GAME:      SPACE BAR", x, y, TextAlignment::kCenter, WHITE);
+    y += spacing;
+    game::DrawString(this->font_, this->font_.baseSize, "PROFILER OVERLAY:      F3", x, y, TextAlignment::kCenter, WHITE);
     y += 2 * spacing;
     auto x1 = x - 200;
     auto x2 = x + 140;
@@ -334,41 +743,42 @@ void Game<N>::DrawStartScreen() const {
     game::DrawString(this->font_, this->font_.baseSize, "RIGHT CONTROL", x2 + 120, y2, TextAlignment::kLeft, WHITE);
 }
 
-template <std::uint8_t N>
-requires ValidPlayerCount<N>
-void Game<N>::UpdateGameOver(const MoveType input) {
+void Game::UpdateGameOver(const MoveType input) {
     if (input == MoveType::kConfirm) {
         for (const auto& player: players_) {
             player->GameOver();
-            player->UpdatePlayer(MoveType::kNone);
+            player->UpdatePlayer(MoveType::kNone, this->frame_time_);
         }
         this->game_phase_ = GameState::kGameStartPhase;
     }
 }
 
-template<std::uint8_t N>
-requires ValidPlayerCount<N>json Game<N>::SaveToJson() {
+json Game::SaveToJson() {
+    TRACE_SCOPE("SaveGame");
     json doc;
-    for (int i = 0; i < N; ++i) {
+    for (size_t i = 0; i < this->players_.size(); ++i) {
         auto tmp = dynamic_cast<ISaveService*>(this->players_.at(i));
         std::string key = "Player" + std::to_string(i);
         doc[key] = tmp->SaveToJson();
     }
-    std::string path = OpenFolderExplorer();
-    if (!path.empty()) {
-        if (CreateSaveFile(path, doc)) {
-            DrawMessageBox("File saved successfully!", this->kScreenWidth_ / 2,
-                           this->kScreenHeight_ / 2);
-        } else {
-            DrawMessageBox("Saving error!", this->kScreenWidth_ / 2,
-                           this->kScreenHeight_ / 2);
-        }
+    // The catalog lists the best board of the match.
+    uint64_t level = 0;
+    uint64_t points = 0;
+    for (const auto& [key, player] : doc.items()) {
+        level = std::max(level, player.value("level", uint64_t{0}));
+        points = std::max(points, player.value("points", uint64_t{0}));
+    }
+    if (this->saves_.Add(doc, static_cast<uint32_t>(this->players_.size()), level, points)) {
+        DrawMessageBox("Game saved successfully!", this->kScreenWidth_ / 2,
+                       this->kScreenHeight_ / 2);
+    } else {
+        DrawMessageBox("Saving error!", this->kScreenWidth_ / 2,
+                       this->kScreenHeight_ / 2);
     }
     return doc;
 }
 
-template<std::uint8_t N>
-requires ValidPlayerCount<N>void Game<N>::PauseGame() {
+void Game::PauseGame() {
     size_t x = this->kScreenWidth_ / 2;
     size_t y = this->kScreenHeight_ / 2 - 80;
     game::DrawString(this->font_, this->font_.baseSize * 2.5,
@@ -381,29 +791,17 @@ requires ValidPlayerCount<N>void Game<N>::PauseGame() {
     if (IsKeyPressed(KEY_Y)) {
         this->SaveToJson();
         this->game_phase_ = GameState::kGamePlayPhase;
+        this->StartSimulation();
     }
     if (IsKeyPressed(KEY_N)) {
         this->game_phase_ = GameState::kGamePlayPhase;
+        this->StartSimulation();
     }
 }
 
-template<std::uint8_t N>
-requires ValidPlayerCount<N>bool Game<N>::LoadFromJson(json ) {
-    std::string path = OpenFileExplorer();
-    if (path.empty()) {
-        std::cerr << "No file selected." << std::endl;
-        return false;
-    }
-    std::string file = ReadFileContents(path);
-    json doc;
-    try {
-        doc = json::parse(file);
-    }
-    catch (const json::parse_error& e) {
-        std::cerr << "Parse error: " << e.what() << std::endl;
-        return false;
-    }
-    for (int i = 0; i < N; ++i) {
+bool Game::LoadFromJson(json doc) {
+    TRACE_SCOPE("LoadGame");
+    for (size_t i = 0; i < this->players_.size(); ++i) {
         std::string key = "Player" + std::to_string(i);
         auto player = dynamic_cast<ISaveService*>(this->players_.at(i));
         if (doc.contains(key)) {
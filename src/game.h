@@ -2,55 +2,139 @@
 
 #include <cstddef>
 #include <raylib.h>
-#include <array>
 #include <type_traits>
 #include <concepts>
 #include <cstdint>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "auto_shift.h"
 #include "i_game.h"
 #include "i_player.h"
 #include "i_save_service.h"
+#include "save_catalog.h"
+#include "spsc_queue.h"
+#include "worker_pool.h"
 
 namespace game {
 
+inline Color kBackgroundColor = BLACK;
+inline const char* font_type = "../src/fonts/novem___.ttf";
+inline const char* save_directory = "saves";
+
 template <typename T>
 concept IsPlayer = std::is_base_of_v<IPlayer, std::remove_reference_t<T>>;
 
-template <std::uint8_t N>
-concept ValidPlayerCount = (N == 1 || N == 2);
-
-template <std::uint8_t N>
-requires ValidPlayerCount<N>
 class Game : public IGame, public ISaveService{
 public:
     template<typename... T>
-    requires (IsPlayer<T>&&...) && (sizeof...(T) == N)
+    requires (IsPlayer<T>&&...) && (sizeof...(T) > 0)
     Game(const size_t screen_height, const size_t screen_width, const char* font, T&&... players)
-        : kScreenHeight_(screen_height),
-         kScreenWidth_(screen_width),
-         players_{&players...},
-         font_type_(font){}
+        : Game(screen_height, screen_width, font, std::vector<IPlayer*>{&players...}) {}
+    // Players are laid out in a grid scaled to fit the window. Throws
+    // std::invalid_argument if players is empty.
+    Game(const size_t screen_height, const size_t screen_width, const char* font, std::vector<IPlayer*> players);
     ~Game() override;
     void InitRenderer() override;
     void GameLoop() override;
     [[nodiscard]] std::optional<PlayerMove> GetMoveType() const override;
+    // Saves every player into the save catalog.
     json SaveToJson() override;
+    // Records every game started from the menu into directory, one replay
+    // file per board. Empty turns recording off.
+    void SetReplayDirectory(std::filesystem::path directory);
+    // Delay and repeat rate of held left and right keys, for both keyboard
+    // players. Call before GameLoop.
+    void SetAutoShift(AutoShiftSettings settings);
+    // The same counted in simulation ticks, for NES timing.
+    void SetAutoShift(AutoShiftFrames frames);
+    // Loads a document written by SaveToJson.
     bool LoadFromJson(json obj) override;
 
 private:
     const size_t kScreenHeight_;
     const size_t kScreenWidth_;
     const char* kTitle_ = "Tetris";
-    const std::array<IPlayer*, N> players_;
+    // A move, or a press or release of left or right, stamped with the time
+    // of the frame that polled it.
+    struct InputEvent {
+        enum class Kind : uint8_t { kMove, kPress, kRelease };
+        PlayerMove move;
+        Kind kind = Kind::kMove;
+        std::chrono::steady_clock::time_point time{};
+    };
+    // Result of the last parallel update of one player.
+    struct alignas(kCacheLineSize) PlayerSlot {
+        GameState phase = GameState::kGameStartPhase;
+        // Attacks go to the opponents in turn, this is the next one's distance.
+        size_t next_target = 0;
+    };
+    // Below this many boards per thread the barrier costs more than the updates.
+    static constexpr size_t kMinPlayersPerWorker_ = 8;
+    const std::vector<IPlayer*> players_;
+    std::vector<PlayerSlot> slots_;
+    WorkerPool pool_;
     const char* font_type_;
     Font font_{};
     size_t start_level_ = 0;
     GameState game_phase_ = GameState::kGameStartPhase;
+    bool show_profiler_ = false;
+    // Clock of the main thread, used while the simulation thread is stopped.
+    FrameTime frame_time_{};
+    // During play the boards are stepped on this thread at kTicksPerSecond_.
+    // The main thread only polls input, renders and handles phase changes,
+    // which always stop the simulation first. The thread is started once and
+    // parks on simulation_wake_ between runs, so pausing does not leave a
+    // dead thread's trace buffer behind.
+    static constexpr int kTicksPerSecond_ = 60;
+    std::mutex simulation_mutex_;
+    std::condition_variable_any simulation_wake_;
+    // Set by StartSimulation, cleared by StopSimulation or a top out.
+    std::atomic<bool> simulation_running_{false};
+    // True while a run is stepping the boards, guarded by simulation_mutex_.
+    bool simulation_active_ = false;
+    // Tick a run starts from, and after it the last tick it stepped, so tick
+    // indices keep counting up across runs and main thread frames.
+    FrameTime simulation_tick_{};
+    std::jthread simulation_;
+    SpscQueue<InputEvent, 64> input_queue_;
+    // Held left and right of player 1 and 2, owned by the simulation thread.
+    std::array<AutoShift, 2> auto_shift_;
+    std::atomic<bool> simulation_game_over_{false};
+    SaveCatalog saves_{save_directory};
+    std::filesystem::path replay_directory_;
+    std::vector<ReplayWriter> replays_;
+    // The start screen lists the saves instead of the menu while browsing.
+    bool browsing_saves_ = false;
+    size_t selected_save_ = 0;
 
+    void LayoutPlayers();
+    void UpdateGame(const PlayerMove input);
+    GameState UpdateAllPlayers(const MoveType input, const FrameTime& frame_time);
+    GameState UpdatePlayer(size_t index, MoveType input, const FrameTime& frame_time);
+    void SendGarbage(size_t index);
+    void StartSimulation();
+    void StopSimulation();
+    void SimulationThread(std::stop_token stop);
+    void SimulationLoop(FrameTime& tick);
+    GameState SimulationTick(const FrameTime& tick);
+    void PollShiftKeys();
+    GameState ApplyShifts(size_t index, const FrameTime& until, const FrameTime& tick);
     void RenderGame() const;
     void UpdateGameStart(const MoveType input);
     void UpdateGameOver(const MoveType input);
     void DrawStartScreen() const;
+    void OpenLoadBrowser();
+    void UpdateLoadBrowser(const MoveType input);
+    void DrawLoadBrowser() const;
+    bool LoadSave(const SaveEntry& entry);
     void PauseGame();
+    void StartRecording();
+    void SaveReplays();
 };
 
 void DrawString(Font font, float font_size, const char* msg, size_t x, size_t y, TextAlignment alignment, Color color);
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "common.h"
+
+namespace game {
+
+// Garbage lines sent to one board by its opponents. Any thread may Send, only
+// the thread updating the board may Take. Lives on its own cache line so
+// senders do not invalidate the board they are sending to.
+class alignas(kCacheLineSize) GarbageMailbox {
+public:
+    GarbageMailbox() = default;
+    // Copies come from whole-board copies and are not synchronised with senders.
+    GarbageMailbox(const GarbageMailbox& other)
+        : lines_(other.lines_.load(std::memory_order_relaxed)) {}
+    GarbageMailbox& operator=(const GarbageMailbox& other) {
+        this->lines_.store(other.lines_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    void Send(uint32_t lines) {
+        this->lines_.fetch_add(lines, std::memory_order_relaxed);
+    }
+
+    uint32_t Take() {
+        // Most locks find the mailbox empty, skip the read-modify-write then.
+        if (this->lines_.load(std::memory_order_relaxed) == 0) {
+            return 0;
+        }
+        return this->lines_.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint32_t> lines_{0};
+};
+
+}
@@ -4,23 +4,31 @@
 #include "piece.h"
 
 #include <cstddef>
-#include <vector>
+#include <optional>
+#include <span>
 
 namespace game {
 
 class IBoard {
 public:
-    virtual std::shared_ptr<tetrino[]> GetPiece(const PieceType type) const = 0;
+    virtual const tetrino* GetPiece(const PieceType type) const = 0;
     virtual int GetShadowPieceRowPosition() = 0;
     virtual int GetPieceRowPosition(const PieceType type) const = 0;
     virtual int GetPieceColumnPosition(const PieceType type) const = 0;
     virtual uint16_t GetPieceSize(const PieceType type) const = 0;
+    virtual Shape GetPieceShape(const PieceType type) const = 0;
+    virtual uint8_t GetPieceRotation(const PieceType type) const = 0;
     virtual uint8_t GetBoardHeight() const = 0;
     virtual uint8_t GetBoardWidth() const = 0;
-    virtual std::vector<std::vector<uint8_t>> GetBoard() const = 0;
+    // Cells in row-major order, GetBoardWidth() cells per row.
+    virtual std::span<const uint8_t> GetBoard() const = 0;
     virtual size_t GetClearedLineCount() const = 0;
     virtual bool IsLineClearing(int index) const= 0;
-    virtual GameState UpdateGame(MoveType input) = 0;
+    virtual GameState UpdateGame(MoveType input, const FrameTime& frame_time) = 0;
+    // Whether an UpdateGame at frame_time would move the falling piece one
+    // column in direction (kLeft or kRight): false outside play, during the
+    // NES entry delay and when the piece is blocked.
+    virtual bool CanShift(MoveType direction, const FrameTime& frame_time) const = 0;
     virtual GameState GetActualGamePhase() const = 0;
     virtual size_t GetStartLevel() const = 0;
     virtual size_t GetLevel() const = 0;
@@ -29,6 +37,32 @@ public:
     virtual void StartGame() = 0;
     virtual void PlayGame() = 0;
     virtual void GameOver() = 0;
+    // Adds garbage lines to be inserted when the next piece locks without
+    // clearing. Safe to call from any thread.
+    virtual void QueueGarbage(uint8_t lines) = 0;
+    // Garbage lines earned by clears since the last call.
+    virtual uint32_t TakeOutgoingLines() = 0;
+    virtual void SetAttackTable(const AttackTable& table) = 0;
+    // Restarts the random sequence, redraws the current piece and the queue
+    // and empties the hold slot.
+    // Boards with the same seed and inputs play the same game.
+    virtual void Reseed(uint32_t seed) = 0;
+    virtual uint32_t GetSeed() const = 0;
+    // Empties the board and starts over at the start phase as if newly
+    // constructed with seed, keeping the attack table, preview depth and
+    // timing model. Never allocates, so simulators can reuse boards across
+    // games.
+    virtual void Reset(uint32_t seed, size_t start_level) = 0;
+    // Upcoming shapes, GetPreviewShape(0) is the next piece and index must be
+    // below GetPreviewDepth(). The depth is clamped to 1..6.
+    virtual void SetPreviewDepth(size_t depth) = 0;
+    virtual size_t GetPreviewDepth() const = 0;
+    virtual Shape GetPreviewShape(size_t index) const = 0;
+    // Empty until the first hold.
+    virtual std::optional<Shape> GetHeldShape() const = 0;
+    // Kept across Reset. Switch only between games.
+    virtual void SetTimingModel(TimingModel timing) = 0;
+    virtual TimingModel GetTimingModel() const = 0;
     virtual ~IBoard() = default;
 };
 
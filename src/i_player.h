@@ -1,18 +1,31 @@
 #pragma once
 
+#include <raylib.h>
 #include "common.h"
+#include "replay.h"
 
 namespace game {
 
 class IPlayer {
 public:
     virtual void DrawPlayer() const = 0;
-    virtual GameState UpdatePlayer(MoveType input) = 0;
+    // Places the player at (x, y) scaled relative to its layout size.
+    virtual void SetLayout(int x, int y, float scale) = 0;
+    virtual Vector2 GetLayoutSize() const = 0;
+    virtual GameState UpdatePlayer(MoveType input, const FrameTime& frame_time) = 0;
+    // See IBoard::CanShift.
+    virtual bool CanShift(MoveType direction, const FrameTime& frame_time) const = 0;
     virtual void SetStartLevel(size_t level) = 0;
     virtual void SetFont(const Font &font) = 0;
     virtual void StartGame() = 0;
     virtual void PlayGame() = 0;
     virtual void GameOver() = 0;
+    virtual void QueueGarbage(uint8_t lines) = 0;
+    virtual uint32_t TakeOutgoingLines() = 0;
+    // Reseeds the board and records every call on it into writer, with times
+    // relative to start, until StopRecording.
+    virtual void StartRecording(ReplayWriter& writer, const FrameTime& start) = 0;
+    virtual void StopRecording() = 0;
     virtual ~IPlayer() = default;
 };
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 #include "json.hpp"
 
 namespace game {
@@ -13,4 +16,18 @@ public:
     virtual ~ISaveService() = default;
 };
 
+// Receives a saved board value by value while a streaming parser reads it, so
+// loading needs no intermediate document. Keys and cells match SaveToJson.
+class IStreamLoadable {
+public:
+    virtual void BeginLoad() = 0;
+    // Scalar fields such as "level"; unknown keys are ignored.
+    virtual bool LoadValue(std::string_view key, uint64_t value) = 0;
+    // False if the cell is outside the board.
+    virtual bool LoadCell(size_t row, size_t col, uint8_t value) = 0;
+    // rows and columns are the size of the loaded board, zero if it had none.
+    virtual bool EndLoad(size_t rows, size_t columns) = 0;
+    virtual ~IStreamLoadable() = default;
+};
+
 }
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "common.h"
+#include "piece.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace game {
+
+// Offset of one rotation test, in board rows (down) and columns (right).
+struct Kick {
+    int8_t row;
+    int8_t col;
+};
+
+inline constexpr size_t kKickTests = 5;
+using KickList = std::array<Kick, kKickTests>;
+
+// Rotations a move can ask for, indexes the kick tables.
+enum class Turn : uint8_t {
+    kClockwise, kHalf, kCounterClockwise
+};
+inline constexpr size_t kTurnCount = 3;
+
+constexpr uint8_t GetQuarterTurns(Turn turn) {
+    return static_cast<uint8_t>(turn) + 1;
+}
+
+namespace srs {
+
+// SRS states are 0 (spawn), R, 2 and L. The spawn orientations in kTetrinos
+// are not all SRS spawn states, this is the SRS state of each, by Shape.
+inline constexpr std::array<uint8_t, kShapeCount> kSpawnState{0, 0, 2, 0, 0, 1, 3};
+
+// Kick tables as published for SRS, (x, y) with y pointing up, indexed by
+// the SRS state rotated from. The first test is the rotation in place.
+struct KickXY {
+    int8_t x;
+    int8_t y;
+};
+using KickListXY = std::array<KickXY, kKickTests>;
+using StateKicks = std::array<KickListXY, rotations_count>;
+
+inline constexpr StateKicks kJlstzClockwise{{
+        {{{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}},
+        {{{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}}},
+        {{{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}}},
+        {{{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}}}
+}};
+inline constexpr StateKicks kJlstzCounterClockwise{{
+        {{{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}}},
+        {{{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}}},
+        {{{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}},
+        {{{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}}}
+}};
+inline constexpr StateKicks kIClockwise{{
+        {{{0, 0}, {-2, 0}, {1, 0}, {-2, -1}, {1, 2}}},
+        {{{0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1}}},
+        {{{0, 0}, {2, 0}, {-1, 0}, {2, 1}, {-1, -2}}},
+        {{{0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1}}}
+}};
+inline constexpr StateKicks kICounterClockwise{{
+        {{{0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1}}},
+        {{{0, 0}, {2, 0}, {-1, 0}, {2, 1}, {-1, -2}}},
+        {{{0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1}}},
+        {{{0, 0}, {-2, 0}, {1, 0}, {-2, -1}, {1, 2}}}
+}};
+// SRS has no 180 rotation. It is tried in place, one row up, one column to
+// either side and one row down.
+inline constexpr KickListXY kHalfTurn{{{0, 0}, {0, 1}, {1, 0}, {-1, 0}, {0, -1}}};
+// Every O rotation covers the same cells.
+inline constexpr KickListXY kNoKick{};
+
+}
+
+// Kicks by Shape, box rotation (Piece::GetRotation) and Turn, converted to
+// rows and columns at compile time so a rotation is five mask tests.
+using KickTable = std::array<std::array<std::array<KickList, kTurnCount>, rotations_count>, kShapeCount>;
+
+constexpr KickTable ComputeKickTable() {
+    KickTable table{};
+    for (size_t shape = 0; shape < kShapeCount; ++shape) {
+        const bool is_bar = static_cast<Shape>(shape) == Shape::kBar;
+        const bool is_square = static_cast<Shape>(shape) == Shape::kSquare;
+        for (size_t rotation = 0; rotation < rotations_count; ++rotation) {
+            size_t state = (rotation + srs::kSpawnState[shape]) % rotations_count;
+            const srs::KickListXY* lists[kTurnCount]{
+                    &(is_bar ? srs::kIClockwise : srs::kJlstzClockwise)[state],
+                    &srs::kHalfTurn,
+                    &(is_bar ? srs::kICounterClockwise : srs::kJlstzCounterClockwise)[state]
+            };
+            for (size_t turn = 0; turn < kTurnCount; ++turn) {
+                const auto& list = is_square ? srs::kNoKick : *lists[turn];
+                for (size_t test = 0; test < kKickTests; ++test) {
+                    table[shape][rotation][turn][test] = Kick{static_cast<int8_t>(-list[test].y), list[test].x};
+                }
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr KickTable kKickTable = ComputeKickTable();
+
+constexpr const KickList& GetKicks(Piece piece, Turn turn) {
+    return kKickTable[static_cast<size_t>(piece.GetShape())][piece.GetRotation()][static_cast<size_t>(turn)];
+}
+
+// The T spawns pointing down (SRS state 2): a clockwise turn kicks as 2->L.
+static_assert(GetKicks(Piece{Shape::kPyramid}, Turn::kClockwise)[1].col == 1, "T spawn is SRS state 2");
+static_assert(GetKicks(Piece{Shape::kBar}, Turn::kClockwise)[4].row == -2, "I 0->R kicks up two rows last");
+
+}
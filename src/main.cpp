@@ -1,18 +1,113 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
 #include "player.h"
 #include "game.h"
+#include "shared_export.h"
 
 //#define NDEBUG //uncomment in release to disable assert()
 
 using namespace game;
 
-int main() {
+// Usage: tetris [player-count] [--export <segment-name>] [--record <directory>]
+// [--nes-timing] [--das <ms>] [--arr <ms>] [--preview <1-6>], defaults to two
+// players. --export publishes every board into POSIX shared memory, --record
+// writes a replay of every board for each game, --nes-timing counts NES frames
+// for gravity, entry delay, line clears and held keys. --das and --arr set the
+// delay and repeat rate of held left and right, 0 repeat moves straight to the
+// wall. --preview sets how many upcoming pieces are shown.
+int main(int argc, char* argv[]) {
     const int window_height = 720;
     const int window_width = 880;
-    Board board_1{};
-    Board board_2{};
-    Player player_1{board_1, 0};
-    Player player_2{board_2, window_width / 2};
-    Game<2> game{window_height, window_width, game::font_type, player_1, player_2};
+    const int max_players = 256;
+    int player_count = 2;
+    std::string export_name;
+    std::string replay_directory;
+    TimingModel timing = TimingModel::kRealTime;
+    std::optional<double> das_ms;
+    std::optional<double> arr_ms;
+    size_t preview_depth = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--export" && i + 1 < argc) {
+            export_name = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            replay_directory = argv[++i];
+        } else if (arg == "--nes-timing") {
+            timing = TimingModel::kNesFrames;
+        } else if (arg == "--das" && i + 1 < argc) {
+            das_ms = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--arr" && i + 1 < argc) {
+            arr_ms = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--preview" && i + 1 < argc) {
+            preview_depth = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else {
+            player_count = std::atoi(argv[i]);
+        }
+    }
+    player_count = std::clamp(player_count, 1, max_players);
+
+    std::optional<SharedBoardExport> shared_export;
+    if (!export_name.empty()) {
+        try {
+            shared_export.emplace(export_name, player_count);
+        } catch (const std::exception& error) {
+            std::cerr << "Cannot export boards: " << error.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Players keep references to their boards, so both vectors are sized up
+    // front and never reallocate.
+    std::vector<Board<>> boards(player_count);
+    std::vector<Player> players;
+    players.reserve(player_count);
+    std::vector<IPlayer*> match;
+    match.reserve(player_count);
+    for (auto& board : boards) {
+        board.SetTimingModel(timing);
+        board.SetPreviewDepth(preview_depth);
+        players.emplace_back(board, 0);
+        if (shared_export) {
+            players.back().SetSharedExport(&*shared_export, players.size() - 1);
+        }
+        match.push_back(&players.back());
+    }
+
+    Game game{window_height, window_width, game::font_type, std::move(match)};
+    game.SetReplayDirectory(replay_directory);
+    if (timing == TimingModel::kNesFrames) {
+        // Held keys count whole frames like the board, --das and --arr round to them.
+        AutoShiftFrames frames = kNesAutoShift;
+        auto to_frames = [](double ms) {
+            return static_cast<uint32_t>(std::lround(ms * nes::kFramesPerSecond / 1000.0));
+        };
+        if (das_ms) {
+            frames.delay = to_frames(*das_ms);
+        }
+        if (arr_ms) {
+            frames.repeat = to_frames(*arr_ms);
+        }
+        game.SetAutoShift(frames);
+    } else {
+        AutoShiftSettings auto_shift = kDefaultAutoShift;
+        auto to_duration = [](double ms) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double, std::milli>(ms));
+        };
+        if (das_ms) {
+            auto_shift.delay = to_duration(*das_ms);
+        }
+        if (arr_ms) {
+            auto_shift.repeat = to_duration(*arr_ms);
+        }
+        game.SetAutoShift(auto_shift);
+    }
     game.InitRenderer();
     game.GameLoop();
 
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace game::nes {
+
+// Frames are counted at the simulation's 60 Hz tick rather than the NTSC
+// 60.0988 Hz, so one tick is one frame.
+inline constexpr uint64_t kFramesPerSecond = 60;
+
+// Delayed auto shift: a held direction moves again after kDasDelayFrames,
+// then every kDasRepeatFrames.
+inline constexpr uint32_t kDasDelayFrames = 16;
+inline constexpr uint32_t kDasRepeatFrames = 6;
+
+// Entry delay (ARE) before the next piece takes input: 10 frames when the
+// locked piece's lowest cell is in the bottom two rows, 2 more for every 4
+// rows above that, at most 18.
+constexpr uint32_t EntryDelayFrames(int rows_above_floor) {
+    uint32_t delay = 10 + 2 * static_cast<uint32_t>((rows_above_floor + 2) / 4);
+    return delay < 18 ? delay : 18;
+}
+
+// The line clear animation advances on frames divisible by 4 and takes five
+// steps, so it lasts 17 to 20 frames depending on the frame of the lock.
+constexpr uint32_t LineClearFrames(uint64_t lock_frame) {
+    return 16 + static_cast<uint32_t>(4 - lock_frame % 4);
+}
+
+}
@@ -3,10 +3,8 @@
 #include "common.h"
 #include "tetrino.h"
 
+#include <array>
 #include <cstdint>
-#include <vector>
-#include <memory>
-#include <unordered_map>
 
 namespace game {
 
@@ -14,23 +12,100 @@ using tetrino = uint8_t;
 
 constexpr uint8_t rotations_count = 4; //rotating by 90deg
 
+// Flyweight handle into the rotation tables, which are generated at compile
+// time. Copying or rotating a piece never allocates.
 class Piece {
 public:
-    explicit Piece(Shape shape);
-    Piece(const Piece& other);
-    Piece& operator=(const Piece& other);
-    std::weak_ptr<Piece> FastRotation() const;
-    uint16_t GetDim() const;
-    std::shared_ptr<tetrino[]> GetPiece() const;
-    static void MakeAllRotations();
+    using RotationTable = std::array<std::array<TetrinoPiece, rotations_count>, kShapeCount>;
+    // Bit j of row i is set when cell (i, j) of the box is filled.
+    using RowMasks = std::array<uint8_t, 4>;
+    using RowMaskTable = std::array<std::array<RowMasks, rotations_count>, kShapeCount>;
+
+    constexpr explicit Piece(Shape shape, uint8_t rotation = 0)
+        : shape_(shape), rotation_(rotation) {}
+
+    constexpr Piece FastRotation() const {
+        return this->Rotated(1);
+    }
+
+    // Clockwise by quarter_turns x 90deg.
+    constexpr Piece Rotated(uint8_t quarter_turns) const {
+        return Piece{this->shape_, static_cast<uint8_t>((this->rotation_ + quarter_turns) % rotations_count)};
+    }
+
+    constexpr uint16_t GetDim() const {
+        return kAllRotations[static_cast<size_t>(this->shape_)][this->rotation_].dim;
+    }
+
+    constexpr const tetrino* GetPiece() const {
+        return kAllRotations[static_cast<size_t>(this->shape_)][this->rotation_].shape.data();
+    }
+
+    constexpr const RowMasks& GetRowMasks() const {
+        return kAllRowMasks[static_cast<size_t>(this->shape_)][this->rotation_];
+    }
+
+    constexpr Shape GetShape() const {
+        return this->shape_;
+    }
+
+    constexpr uint8_t GetRotation() const {
+        return this->rotation_;
+    }
+
+    static const RotationTable kAllRotations;
+    static const RowMaskTable kAllRowMasks;
 
 private:
-    std::shared_ptr<Tetrino::TetrinoPiece> tetrino_;
-    std::weak_ptr<Piece> next_;
-    static bool all_rotations_computed_;
-    static std::unordered_map<Shape, std::array<std::shared_ptr<Piece>, rotations_count>> kAllRotations;
-    static void ComputeNextRotation(const std::shared_ptr<Piece>& rotated_piece,
-                                    const std::shared_ptr<Piece>& prev_piece);
+    Shape shape_;
+    uint8_t rotation_;
+
+    // Clockwise rotation by 90deg within the dim x dim box.
+    static constexpr TetrinoPiece ComputeNextRotation(const TetrinoPiece& prev_piece) {
+        TetrinoPiece rotated_piece{{}, prev_piece.dim};
+        uint16_t count = 0;
+        for (int i = 0; i < rotated_piece.dim; i++) {
+            for (int j = 0; j < rotated_piece.dim; j++) {
+                rotated_piece.shape[count++] = prev_piece.shape[
+                        (prev_piece.dim - j - 1) * prev_piece.dim + i];
+            }
+        }
+        return rotated_piece;
+    }
+
+    static constexpr RotationTable ComputeAllRotations() {
+        RotationTable table{};
+        for (size_t shape = 0; shape < kShapeCount; ++shape) {
+            table[shape][0] = kTetrinos[shape];
+            for (int i = 1; i < rotations_count; ++i) {
+                table[shape][i] = ComputeNextRotation(table[shape][i - 1]);
+            }
+        }
+        return table;
+    }
+
+    static constexpr RowMaskTable ComputeAllRowMasks() {
+        RowMaskTable table{};
+        for (size_t shape = 0; shape < kShapeCount; ++shape) {
+            for (size_t rotation = 0; rotation < rotations_count; ++rotation) {
+                const auto& piece = kAllRotations[shape][rotation];
+                for (int i = 0; i < piece.dim; ++i) {
+                    for (int j = 0; j < piece.dim; ++j) {
+                        if (piece.shape[i * piece.dim + j]) {
+                            table[shape][rotation][i] |= static_cast<uint8_t>(1u << j);
+                        }
+                    }
+                }
+            }
+        }
+        return table;
+    }
 };
 
-}
\ No newline at end of file
+inline constexpr Piece::RotationTable Piece::kAllRotations = Piece::ComputeAllRotations();
+inline constexpr Piece::RowMaskTable Piece::kAllRowMasks = Piece::ComputeAllRowMasks();
+
+static_assert(Piece{Shape::kBar, 1}.GetPiece()[2] == 2, "vertical bar occupies column 2");
+static_assert(Piece{Shape::kBar, 1}.GetRowMasks()[3] == 0b0100, "vertical bar occupies column 2");
+
+}
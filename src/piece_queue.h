@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include "common.h"
+
+namespace game {
+
+// Upcoming shapes of a board in a fixed ring buffer. Whenever fewer than
+// kMaxPreview shapes are left it is topped up with a batch of kBatch from the
+// board's generator, so the generator runs once every few spawns and the
+// queue never allocates.
+class PieceQueue {
+public:
+    static constexpr size_t kMinPreview = 1;
+    static constexpr size_t kMaxPreview = 6;
+    static constexpr size_t kBatch = 8;
+    // A power of two, so wrapping is a mask.
+    static constexpr size_t kCapacity = 16;
+    static_assert(kMaxPreview - 1 + kBatch <= kCapacity, "a refill must fit");
+
+    template <typename Generator>
+    void Fill(Generator&& generate) {
+        if (this->size_ >= kMaxPreview) {
+            return;
+        }
+        for (size_t i = 0; i < kBatch; ++i) {
+            this->shapes_[(this->head_ + this->size_) & kMask_] = generate();
+            ++this->size_;
+        }
+    }
+
+    // Takes the front shape, call Fill before the next Peek or Pop.
+    Shape Pop() {
+        assert(this->size_ > 0);
+        Shape shape = this->shapes_[this->head_];
+        this->head_ = (this->head_ + 1) & kMask_;
+        --this->size_;
+        return shape;
+    }
+
+    // index 0 is the next shape. Valid up to kMaxPreview - 1 after Fill.
+    Shape Peek(size_t index) const {
+        assert(index < this->size_);
+        return this->shapes_[(this->head_ + index) & kMask_];
+    }
+
+    size_t Size() const {
+        return this->size_;
+    }
+
+    void Clear() {
+        this->head_ = 0;
+        this->size_ = 0;
+    }
+
+private:
+    static constexpr size_t kMask_ = kCapacity - 1;
+    static_assert((kCapacity & kMask_) == 0, "capacity must be a power of two");
+    std::array<Shape, kCapacity> shapes_{};
+    size_t head_ = 0;
+    size_t size_ = 0;
+};
+
+}
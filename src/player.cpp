@@ -1,42 +1,107 @@
+#include <algorithm>
 #include <iostream>
 #include "player.h"
 #include "color.h"
 #include "game.h"
+#include "profiler.h"
 
 namespace game {
 
 Player::Player(IBoard &board, const int x_offset)
-    : kMarginX_(x_offset), board_(board) {
+    : board_(board),
+      board_loader_(dynamic_cast<IStreamLoadable*>(&board)) {
+    this->SetLayout(x_offset, 0, 1.0f);
+    this->PublishSnapshot();
+}
+
+void Player::PublishSnapshot() {
+    auto& snapshot = this->snapshots_.GetWriteBuffer();
+    auto board = this->board_.GetBoard();
+    snapshot.width = this->board_.GetBoardWidth();
+    snapshot.height = this->board_.GetBoardHeight();
+    snapshot.cells.assign(board.begin(), board.end());
+    snapshot.clearing_rows.resize(snapshot.height);
+    for (int i = 0; i < snapshot.height; ++i) {
+        snapshot.clearing_rows[i] = this->board_.IsLineClearing(i);
+    }
+    this->CapturePiece(PieceType::kActualPiece, snapshot.actual_piece);
+    this->CapturePiece(PieceType::kNextPiece, snapshot.next_piece);
+    snapshot.preview_count = static_cast<uint8_t>(this->board_.GetPreviewDepth() - 1);
+    for (size_t i = 0; i < snapshot.preview_count; ++i) {
+        snapshot.preview[i] = this->board_.GetPreviewShape(i + 1);
+    }
+    snapshot.held = this->board_.GetHeldShape();
+    snapshot.shadow_row = this->board_.GetShadowPieceRowPosition();
+    snapshot.level = this->board_.GetLevel();
+    snapshot.points = this->board_.GetPoints();
+    snapshot.cleared_lines = this->board_.GetClearedLineCount();
+    snapshot.phase = this->board_.GetActualGamePhase();
+    this->snapshots_.Publish();
+    if (this->shared_export_ != nullptr) {
+        this->shared_export_->Publish(this->export_index_, this->board_, this->last_tick_);
+    }
+}
+
+void Player::SetSharedExport(SharedBoardExport* shared_export, size_t index) {
+    this->shared_export_ = shared_export;
+    this->export_index_ = index;
+    this->PublishSnapshot();
+}
+
+void Player::CapturePiece(PieceType type, BoardSnapshot::PieceView& view) const {
+    view.size = this->board_.GetPieceSize(type);
+    view.row = this->board_.GetPieceRowPosition(type);
+    view.col = this->board_.GetPieceColumnPosition(type);
+    const tetrino* cells = this->board_.GetPiece(type);
+    std::copy(cells, cells + view.size * view.size, view.cells.begin());
+}
+
+void Player::SetLayout(int x, int y, float scale) {
+    this->x_ = x;
+    this->y_ = y;
+    this->scale_ = scale;
+    this->grid_size_ = std::max(1, static_cast<int>(kBaseGridSize_ * scale));
+    this->margin_x_ = x;
+    this->margin_y_ = y + static_cast<int>(kBaseMarginY_ * scale);
+}
+
+Vector2 Player::GetLayoutSize() const {
+    return Vector2{static_cast<float>(this->board_.GetBoardWidth() * kBaseGridSize_ + kBaseInfoWidth_),
+                   static_cast<float>(kBaseMarginY_ + this->board_.GetBoardHeight() * kBaseGridSize_)};
+}
+
+bool Player::ShowsGameInfo() const {
+    return this->grid_size_ >= kMinInfoGridSize_;
 }
 
 void Player::DrawPlayer() const{
-    if (this->board_.GetActualGamePhase() == GameState::kGamePlayPhase) {
-        this->DrawPiece(PieceType::kActualPiece, this->kMarginX_, this->kMarginY_);
-        this->DrawStartOverlap();
-        this->DrawBoard();
-        this->DrawShadowPiece();
-        this->DrawGameInfo();
+    const auto& snapshot = this->snapshots_.Read();
+    if (snapshot.phase == GameState::kGamePlayPhase) {
+        this->DrawPiece(snapshot.actual_piece, this->margin_x_, this->margin_y_);
+        this->DrawStartOverlap(snapshot);
+        this->DrawBoard(snapshot);
+        this->DrawShadowPiece(snapshot);
+        this->DrawGameInfo(snapshot);
     }
-    if (this->board_.GetActualGamePhase() == GameState::kGameLinePhase) {
-        this->DrawBoard();
-        this->DrawLineClearingHighlight();
-        this->DrawGameInfo();
+    if (snapshot.phase == GameState::kGameLinePhase) {
+        this->DrawBoard(snapshot);
+        this->DrawLineClearingHighlight(snapshot);
+        this->DrawGameInfo(snapshot);
     }
-    if (this->board_.GetActualGamePhase() == GameState::kGameOverPhase) {
-        this->DrawBoard();
-        this->DrawGameInfo();
+    if (snapshot.phase == GameState::kGameOverPhase) {
+        this->DrawBoard(snapshot);
+        this->DrawGameInfo(snapshot);
     }
 }
 
-void Player::DrawPiece(PieceType type, const int x_offset,  const int y_offset) const{
-    auto piece_size = this->board_.GetPieceSize(type);
-    auto piece_shape = this->board_.GetPiece(type).get();
-    for (int i = 0; i < piece_size; ++i) {
-        for (int j = 0; j < piece_size; ++j) {
+void Player::DrawPiece(const BoardSnapshot::PieceView& piece, const int x_offset,  const int y_offset) const{
+    auto piece_shape = piece.cells.data();
+    for (int i = 0; i < piece.size; ++i) {
+        for (int j = 0; j < piece.size; ++j) {
             uint8_t value = *piece_shape++;
             if (value) {
-                int row = this->board_.GetPieceRowPosition(type) + i;
-                int col = this->board_.GetPieceColumnPosition(type) + j;
+                int row = piece.row + i;
+                int col = piece.col + j;
                 DrawCell(row, col, x_offset, y_offset, value, false);
             }
         }
@@ -55,95 +120,155 @@ void Player::DrawCell(int row, int col, const int x_offset, const int y_offset,
     Color dark_color {dark_color_scheme.GetRValue(), dark_color_scheme.GetGValue(),
                       dark_color_scheme.GetBValue(), dark_color_scheme.GetAValue()};
 
-    int edge = this->kGridSize_ / 8;
-    int x = col * this->kGridSize_ + x_offset;
-    int y = row * this->kGridSize_ + y_offset;
+    int edge = this->grid_size_ / 8;
+    int x = col * this->grid_size_ + x_offset;
+    int y = row * this->grid_size_ + y_offset;
 
     if (outline) {
-        DrawRectangleLines(x, y, this->kGridSize_, this->kGridSize_, base_color);
+        DrawRectangleLines(x, y, this->grid_size_, this->grid_size_, base_color);
+        PROFILE_DRAW_CALLS(1);
         return;
     }
 
     if (value) {
-        DrawRectangle(x, y, this->kGridSize_, this->kGridSize_, dark_color);
-        DrawRectangle(x + edge, y, this->kGridSize_ - edge, this->kGridSize_ - edge, light_color);
-        DrawRectangle(x + edge, y + edge, this->kGridSize_ - edge * 2,
-                      this->kGridSize_ - edge * 2, base_color);
+        PROFILE_DRAW_CALLS(3);
+        DrawRectangle(x, y, this->grid_size_, this->grid_size_, dark_color);
+        DrawRectangle(x + edge, y, this->grid_size_ - edge, this->grid_size_ - edge, light_color);
+        DrawRectangle(x + edge, y + edge, this->grid_size_ - edge * 2,
+                      this->grid_size_ - edge * 2, base_color);
     }
 }
 
-void Player::DrawBoard() const{
-    auto board = this->board_.GetBoard();
-    int board_height = this->board_.GetBoardHeight();
-    int board_width = this->board_.GetBoardWidth();
+void Player::DrawBoard(const BoardSnapshot& snapshot) const{
+    int board_height = snapshot.height;
+    int board_width = snapshot.width;
     for (int i = 0; i < board_height; ++i) {
         for (int j = 0; j < board_width; ++j) {
-            uint8_t value = board.at(i).at(j);
-            this->DrawCell(i, j, this->kMarginX_, this->kMarginY_, value, false);
+            uint8_t value = snapshot.cells[i * board_width + j];
+            this->DrawCell(i, j, this->margin_x_, this->margin_y_, value, false);
         }
     }
-    DrawBoardOutline();
+    DrawBoardOutline(snapshot);
 }
 
-void Player::DrawBoardOutline() const {
-    int width = this->board_.GetBoardWidth() * this->kGridSize_;
-    int height = this->board_.GetBoardHeight() * this->kGridSize_;
-    DrawRectangleLines(this->kMarginX_, this->kMarginY_, width, height, WHITE);
+void Player::DrawBoardOutline(const BoardSnapshot& snapshot) const {
+    int width = snapshot.width * this->grid_size_;
+    int height = snapshot.height * this->grid_size_;
+    DrawRectangleLines(this->margin_x_, this->margin_y_, width, height, WHITE);
+    PROFILE_DRAW_CALLS(1);
 }
 
-void Player::DrawLineClearingHighlight() const {
-    for (int i = 0; i < this->board_.GetBoardHeight(); ++i) {
-        if (this->board_.IsLineClearing(i)) {
-            DrawRectangle(this->kMarginX_, i * this->kGridSize_ + this->kMarginY_, this->kGridSize_ * this->board_.GetBoardWidth(),
-                          this->kGridSize_, WHITE);
+void Player::DrawLineClearingHighlight(const BoardSnapshot& snapshot) const {
+    for (int i = 0; i < snapshot.height; ++i) {
+        if (snapshot.clearing_rows[i]) {
+            DrawRectangle(this->margin_x_, i * this->grid_size_ + this->margin_y_, this->grid_size_ * snapshot.width,
+                          this->grid_size_, WHITE);
+            PROFILE_DRAW_CALLS(1);
         }
     }
 }
 
-void Player::DrawGameInfo() const {
+void Player::DrawGameInfo(const BoardSnapshot& snapshot) const {
+    if (!this->ShowsGameInfo()) {
+        return;
+    }
     char buffer[2048];
-    std::sprintf(buffer, "LEVEL: %ld", this->board_.GetLevel());
-    float x = this->kMarginX_;
-    float y = 0;
-    float spacing = 30;
-    game::DrawString(this->font_, this->font_.baseSize, buffer, x, y, TextAlignment::kLeft, WHITE);
-    std::sprintf(buffer, "CLEARED LINES: %ld", this->board_.GetClearedLineCount());
-    game::DrawString(this->font_, this->font_.baseSize, buffer, x + 120, y, TextAlignment::kLeft, WHITE);
-    std::sprintf(buffer, "POINTS: %ld", this->board_.GetPoints());
-    game::DrawString(this->font_, this->font_.baseSize, buffer, x, y + spacing, TextAlignment::kLeft, WHITE);
-
-    x = this->kMarginX_ + 330;
-    y = 60;
-    game::DrawString(this->font_, this->font_.baseSize, "NEXT PIECE", x, y, TextAlignment::kLeft, WHITE);
-    DrawRectangleLines(x - 20, y, 120, y + 90, WHITE);
-    x = 250 - (this->board_.GetPieceSize(PieceType::kNextPiece) * this->kGridSize_) / 2 +
-            this->kMarginX_;
-    y = 100;
-    this->DrawPiece(PieceType::kNextPiece, x, y);
-}
-
-void Player::DrawStartOverlap() const {
-    DrawRectangle(this->kMarginX_, this->kMarginY_, this->board_.GetBoardWidth() * this->kGridSize_,
-                  2 * this->kGridSize_, game::kBackgroundColor);
-}
-
-void Player::DrawShadowPiece() const {
-    auto piece_size = this->board_.GetPieceSize(PieceType::kActualPiece);
-    auto piece_shape = this->board_.GetPiece(PieceType::kActualPiece).get();
-    for (int i = 0; i < piece_size; ++i) {
-        for (int j = 0; j < piece_size; ++j) {
+    const float font_size = this->font_.baseSize * this->scale_;
+    std::sprintf(buffer, "LEVEL: %ld", snapshot.level);
+    float x = this->x_;
+    float y = this->y_;
+    float spacing = 30 * this->scale_;
+    game::DrawString(this->font_, font_size, buffer, x, y, TextAlignment::kLeft, WHITE);
+    std::sprintf(buffer, "CLEARED LINES: %ld", snapshot.cleared_lines);
+    game::DrawString(this->font_, font_size, buffer, x + 120 * this->scale_, y, TextAlignment::kLeft, WHITE);
+    std::sprintf(buffer, "POINTS: %ld", snapshot.points);
+    game::DrawString(this->font_, font_size, buffer, x, y + spacing, TextAlignment::kLeft, WHITE);
+
+    const float board_width = snapshot.width * this->grid_size_;
+    x = this->margin_x_ + board_width + 30 * this->scale_;
+    y = this->margin_y_;
+    game::DrawString(this->font_, font_size, "NEXT PIECE", x, y, TextAlignment::kLeft, WHITE);
+    DrawRectangleLines(x - 20 * this->scale_, y, 120 * this->scale_, 150 * this->scale_, WHITE);
+    PROFILE_DRAW_CALLS(1);
+    // DrawPiece adds the spawn column, shift it back to centre the piece in the box.
+    const int spawn_col = snapshot.next_piece.col;
+    x = x + 40 * this->scale_ - (snapshot.next_piece.size * this->grid_size_) / 2.0f -
+        spawn_col * this->grid_size_;
+    y = this->y_ + 100 * this->scale_;
+    this->DrawPiece(snapshot.next_piece, x, y);
+
+    // The rest of the preview and the hold slot at half size under the box.
+    const int small_grid = std::max(1, this->grid_size_ / 2);
+    x = this->margin_x_ + board_width + 30 * this->scale_;
+    y = this->margin_y_ + 160 * this->scale_;
+    for (size_t i = 0; i < snapshot.preview_count; ++i) {
+        this->DrawSmallPiece(snapshot.preview[i], x, y + i * 4 * small_grid, small_grid);
+    }
+    y += (PieceQueue::kMaxPreview - 1) * 4 * small_grid + 10 * this->scale_;
+    game::DrawString(this->font_, font_size, "HOLD", x, y, TextAlignment::kLeft, WHITE);
+    if (snapshot.held) {
+        this->DrawSmallPiece(*snapshot.held, x, y + spacing, small_grid);
+    }
+}
+
+void Player::DrawSmallPiece(Shape shape, float x, float y, int cell_size) const {
+    Piece piece{shape};
+    const tetrino* cells = piece.GetPiece();
+    for (int i = 0; i < piece.GetDim(); ++i) {
+        for (int j = 0; j < piece.GetDim(); ++j) {
+            uint8_t value = *cells++;
+            if (value) {
+                auto scheme = ColorScheme(ColorSchemes::kBaseColors, value);
+                Color color{scheme.GetRValue(), scheme.GetGValue(), scheme.GetBValue(), scheme.GetAValue()};
+                DrawRectangle(static_cast<int>(x) + j * cell_size, static_cast<int>(y) + i * cell_size,
+                              cell_size - 1, cell_size - 1, color);
+                PROFILE_DRAW_CALLS(1);
+            }
+        }
+    }
+}
+
+void Player::DrawStartOverlap(const BoardSnapshot& snapshot) const {
+    DrawRectangle(this->margin_x_, this->margin_y_, snapshot.width * this->grid_size_,
+                  2 * this->grid_size_, game::kBackgroundColor);
+    PROFILE_DRAW_CALLS(1);
+}
+
+void Player::DrawShadowPiece(const BoardSnapshot& snapshot) const {
+    const auto& piece = snapshot.actual_piece;
+    auto piece_shape = piece.cells.data();
+    for (int i = 0; i < piece.size; ++i) {
+        for (int j = 0; j < piece.size; ++j) {
             uint8_t value = *piece_shape++;
             if (value) {
-                int row = this->board_.GetShadowPieceRowPosition() + i;
-                int col = this->board_.GetPieceColumnPosition(PieceType::kActualPiece) + j;
-                DrawCell(row, col, this->kMarginX_, this->kMarginY_, value, true);
+                int row = snapshot.shadow_row + i;
+                int col = piece.col + j;
+                DrawCell(row, col, this->margin_x_, this->margin_y_, value, true);
             }
         }
     }
 }
 
-GameState Player::UpdatePlayer(MoveType input) {
-    return this->board_.UpdateGame(input);
+GameState Player::UpdatePlayer(MoveType input, const FrameTime& frame_time) {
+    if (this->recorder_ != nullptr) {
+        for (uint32_t lines = this->recorded_garbage_.Take(); lines > 0;) {
+            uint8_t part = static_cast<uint8_t>(std::min<uint32_t>(lines, UINT8_MAX));
+            this->Record(ReplayEvent{ReplayEvent::Type::kGarbage, MoveType::kNone, 0, part});
+            this->board_.QueueGarbage(part);
+            lines -= part;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(frame_time.now - this->record_start_);
+        this->Record(ReplayEvent{ReplayEvent::Type::kUpdate, input,
+                                 static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 0))});
+    }
+    GameState phase = this->board_.UpdateGame(input, frame_time);
+    this->last_tick_ = frame_time.index;
+    this->PublishSnapshot();
+    return phase;
+}
+
+bool Player::CanShift(MoveType direction, const FrameTime& frame_time) const {
+    return this->board_.CanShift(direction, frame_time);
 }
 
 void Player::SetStartLevel(size_t level) {
@@ -155,15 +280,33 @@ void Player::SetFont(const Font& font) {
 }
 
 void Player::StartGame() {
+    this->Record(ReplayEvent{ReplayEvent::Type::kStartGame});
     this->board_.StartGame();
+    this->PublishSnapshot();
 }
 
 void Player::PlayGame() {
+    this->Record(ReplayEvent{ReplayEvent::Type::kPlayGame});
     this->board_.PlayGame();
+    this->PublishSnapshot();
 }
 
 void Player::GameOver() {
+    this->Record(ReplayEvent{ReplayEvent::Type::kGameOver});
     this->board_.GameOver();
+    this->PublishSnapshot();
+}
+
+void Player::QueueGarbage(uint8_t lines) {
+    if (this->recorder_ != nullptr) {
+        this->recorded_garbage_.Send(lines);
+    } else {
+        this->board_.QueueGarbage(lines);
+    }
+}
+
+uint32_t Player::TakeOutgoingLines() {
+    return this->board_.TakeOutgoingLines();
 }
 
 json Player::SaveToJson() {
@@ -174,8 +317,54 @@ json Player::SaveToJson() {
 bool Player::LoadFromJson(json obj) {
     auto tmp = dynamic_cast<ISaveService*>(&this->board_);
     tmp->LoadFromJson(obj);
+    this->PublishSnapshot();
 
     return true;
 }
 
-}
\ No newline at end of file
+
+void Player::BeginLoad() {
+    if (this->board_loader_ != nullptr) {
+        this->board_loader_->BeginLoad();
+    }
+}
+
+bool Player::LoadValue(std::string_view key, uint64_t value) {
+    return this->board_loader_ != nullptr && this->board_loader_->LoadValue(key, value);
+}
+
+bool Player::LoadCell(size_t row, size_t col, uint8_t value) {
+    return this->board_loader_ != nullptr && this->board_loader_->LoadCell(row, col, value);
+}
+
+bool Player::EndLoad(size_t rows, size_t columns) {
+    bool loaded = this->board_loader_ != nullptr && this->board_loader_->EndLoad(rows, columns);
+    this->PublishSnapshot();
+    return loaded;
+}
+
+
+void Player::StartRecording(ReplayWriter& writer, const FrameTime& start) {
+    uint32_t seed = this->board_.GetSeed();
+    this->board_.Reseed(seed);
+    writer.Begin(ReplayHeader{seed, static_cast<uint32_t>(this->board_.GetStartLevel()),
+                              this->board_.GetBoardWidth(), this->board_.GetBoardHeight(),
+                              this->board_.GetTimingModel()});
+    this->recorder_ = &writer;
+    this->record_start_ = start.now;
+    this->PublishSnapshot();
+}
+
+void Player::StopRecording() {
+    this->recorder_ = nullptr;
+    // Garbage that arrived after the last recorded update is not part of the game.
+    this->recorded_garbage_.Take();
+}
+
+void Player::Record(const ReplayEvent& event) {
+    if (this->recorder_ != nullptr) {
+        this->recorder_->Record(event);
+    }
+}
+
+}
@@ -3,38 +3,82 @@
 #include <cstddef>
 #include <raylib.h>
 #include "board.h"
+#include "board_snapshot.h"
+#include "garbage_mailbox.h"
 #include "i_player.h"
+#include "shared_export.h"
+#include "triple_buffer.h"
 
 namespace game {
 
-class Player : public IPlayer, public ISaveService{
+// Draws one board. Updates may run on another thread than DrawPlayer: every
+// update publishes a snapshot of the board and drawing reads the newest one.
+class Player : public IPlayer, public ISaveService, public IStreamLoadable{
 public:
     explicit Player(IBoard &board, const int x_offset);
     void DrawPlayer() const override;
-    GameState UpdatePlayer(MoveType input) override;
+    void SetLayout(int x, int y, float scale) override;
+    Vector2 GetLayoutSize() const override;
+    GameState UpdatePlayer(MoveType input, const FrameTime& frame_time) override;
+    bool CanShift(MoveType direction, const FrameTime& frame_time) const override;
     void SetStartLevel(size_t level) override;
     void SetFont(const Font &font) override;
     void StartGame() override;
     void PlayGame() override;
     void GameOver() override;
+    void QueueGarbage(uint8_t lines) override;
+    uint32_t TakeOutgoingLines() override;
+    void StartRecording(ReplayWriter& writer, const FrameTime& start) override;
+    void StopRecording() override;
     json SaveToJson() override;
     bool LoadFromJson(json obj) override;
+    void BeginLoad() override;
+    bool LoadValue(std::string_view key, uint64_t value) override;
+    bool LoadCell(size_t row, size_t col, uint8_t value) override;
+    bool EndLoad(size_t rows, size_t columns) override;
+    // Also publishes every update into slot index of shared_export, which
+    // must outlive the player. Pass nullptr to stop.
+    void SetSharedExport(SharedBoardExport* shared_export, size_t index);
 
 private:
-    const int kGridSize_ = 30;
-    const int kMarginY_ = 60;
-    const int kMarginX_;
+    static constexpr int kBaseGridSize_ = 30;
+    static constexpr int kBaseMarginY_ = 60;
+    static constexpr int kBaseInfoWidth_ = 140;
+    static constexpr int kMinInfoGridSize_ = 12;
+    int x_ = 0;
+    int y_ = 0;
+    float scale_ = 1.0f;
+    int grid_size_ = kBaseGridSize_;
+    int margin_x_ = 0;
+    int margin_y_ = kBaseMarginY_;
     IBoard &board_;
+    // The board's own loader, null if it cannot stream.
+    IStreamLoadable* board_loader_;
     Font font_{};
+    // Reading swaps buffers, hence mutable for the const draw path.
+    mutable TripleBuffer<BoardSnapshot> snapshots_;
+    SharedBoardExport* shared_export_ = nullptr;
+    size_t export_index_ = 0;
+    uint64_t last_tick_ = 0;
+    ReplayWriter* recorder_ = nullptr;
+    std::chrono::steady_clock::time_point record_start_{};
+    // While recording, garbage from opponents waits here and is passed to the
+    // board on its own update, so it lands in the replay in order.
+    GarbageMailbox recorded_garbage_;
 
-    void DrawPiece(PieceType type, const int x_offset, const int y_offset) const;
-    void DrawBoard() const;
+    void PublishSnapshot();
+    void Record(const ReplayEvent& event);
+    void CapturePiece(PieceType type, BoardSnapshot::PieceView& view) const;
+    void DrawPiece(const BoardSnapshot::PieceView& piece, const int x_offset, const int y_offset) const;
+    void DrawSmallPiece(Shape shape, float x, float y, int cell_size) const;
+    void DrawBoard(const BoardSnapshot& snapshot) const;
     void DrawCell(int row, int col, const int x_offset, const int y_offset, int value, bool outline) const;
-    void DrawBoardOutline() const;
-    void DrawLineClearingHighlight() const;
-    void DrawGameInfo() const;
-    void DrawStartOverlap() const;
-    void DrawShadowPiece() const;
+    void DrawBoardOutline(const BoardSnapshot& snapshot) const;
+    void DrawLineClearingHighlight(const BoardSnapshot& snapshot) const;
+    void DrawGameInfo(const BoardSnapshot& snapshot) const;
+    void DrawStartOverlap(const BoardSnapshot& snapshot) const;
+    void DrawShadowPiece(const BoardSnapshot& snapshot) const;
+    bool ShowsGameInfo() const;
 };
 
 }
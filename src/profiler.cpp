@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <atomic>
+#include "alloc_stats.h"
+#include "common.h"
+#include "profiler.h"
+
+namespace game::profiler {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Running zone totals of one thread. Boards are updated on many threads, so
+// each thread adds to its own cache line and EndFrame sums them, keeping
+// the totals of its last read to take the difference.
+struct alignas(kCacheLineSize) ThreadTotals {
+    std::array<std::atomic<uint64_t>, kZoneCount> ns{};
+    std::array<std::atomic<uint64_t>, kZoneCount> calls{};
+};
+
+// Threads past the last slot share it.
+constexpr size_t kMaxThreads = 64;
+std::array<ThreadTotals, kMaxThreads> thread_totals{};
+std::atomic<size_t> thread_count{0};
+thread_local ThreadTotals* local_totals = nullptr;
+std::array<uint64_t, kZoneCount> last_zone_ns{};
+std::array<uint64_t, kZoneCount> last_zone_calls{};
+
+// Running totals of one player. A player is updated by one thread at a
+// time, so the slots need no sharding, only a cache line each.
+struct alignas(kCacheLineSize) PlayerTotals {
+    std::array<std::atomic<uint64_t>, kZoneCount> ns{};
+};
+
+std::array<PlayerTotals, kMaxPlayers> player_totals{};
+// One past the highest player index seen.
+std::atomic<size_t> player_count{0};
+std::array<std::array<uint64_t, kZoneCount>, kMaxPlayers> last_player_ns{};
+std::atomic<uint32_t> draw_calls{0};
+
+ThreadTotals& GetThreadTotals() {
+    if (local_totals == nullptr) {
+        size_t index = thread_count.fetch_add(1, std::memory_order_relaxed);
+        local_totals = &thread_totals[std::min(index, kMaxThreads - 1)];
+    }
+    return *local_totals;
+}
+
+std::array<FrameStats, kHistorySize> history{};
+size_t history_head = 0;
+size_t history_count = 0;
+Clock::time_point last_frame_end = Clock::now();
+size_t last_allocations = 0;
+
+}
+
+ScopedZone::ScopedZone(Zone zone, size_t player)
+    : zone_(zone), player_(player), start_(Clock::now()) {
+#ifdef TETRIS_TRACE
+    trace::Begin(GetZoneName(zone));
+#endif
+}
+
+ScopedZone::~ScopedZone() {
+#ifdef TETRIS_TRACE
+    trace::End(GetZoneName(this->zone_));
+#endif
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - this->start_);
+    auto index = static_cast<size_t>(this->zone_);
+    auto& totals = GetThreadTotals();
+    totals.ns[index].fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+    totals.calls[index].fetch_add(1, std::memory_order_relaxed);
+    if (this->player_ != kNoPlayer) {
+        size_t player = std::min(this->player_, kMaxPlayers - 1);
+        player_totals[player].ns[index].fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+        size_t count = player_count.load(std::memory_order_relaxed);
+        while (count <= player && !player_count.compare_exchange_weak(count, player + 1, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+void AddDrawCalls(uint32_t count) {
+    draw_calls.fetch_add(count, std::memory_order_relaxed);
+}
+
+void EndFrame() {
+    auto now = Clock::now();
+    auto allocations = alloc_stats::Current().allocations;
+
+    history_head = (history_head + 1) % kHistorySize;
+    auto& frame = history[history_head];
+    frame.frame_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_frame_end).count());
+    const size_t threads = std::min(thread_count.load(std::memory_order_relaxed), kMaxThreads);
+    for (size_t i = 0; i < kZoneCount; ++i) {
+        uint64_t total_ns = 0;
+        uint64_t total_calls = 0;
+        for (size_t thread = 0; thread < threads; ++thread) {
+            total_ns += thread_totals[thread].ns[i].load(std::memory_order_relaxed);
+            total_calls += thread_totals[thread].calls[i].load(std::memory_order_relaxed);
+        }
+        frame.zone_ns[i] = total_ns - last_zone_ns[i];
+        frame.zone_calls[i] = static_cast<uint32_t>(total_calls - last_zone_calls[i]);
+        last_zone_ns[i] = total_ns;
+        last_zone_calls[i] = total_calls;
+    }
+    frame.slowest_player.fill(kNoPlayer);
+    frame.slowest_player_ns.fill(0);
+    const size_t players = player_count.load(std::memory_order_relaxed);
+    for (size_t player = 0; player < players; ++player) {
+        for (size_t i = 0; i < kZoneCount; ++i) {
+            uint64_t total_ns = player_totals[player].ns[i].load(std::memory_order_relaxed);
+            uint64_t frame_ns = total_ns - last_player_ns[player][i];
+            last_player_ns[player][i] = total_ns;
+            if (frame_ns > frame.slowest_player_ns[i]) {
+                frame.slowest_player[i] = player;
+                frame.slowest_player_ns[i] = frame_ns;
+            }
+        }
+    }
+    frame.draw_calls = draw_calls.exchange(0, std::memory_order_relaxed);
+    frame.allocations = allocations - last_allocations;
+    if (history_count < kHistorySize) {
+        ++history_count;
+    }
+
+    last_frame_end = now;
+    last_allocations = allocations;
+}
+
+const FrameStats& GetFrame(size_t age) {
+    return history[(history_head + kHistorySize - age % kHistorySize) % kHistorySize];
+}
+
+size_t GetFrameCount() {
+    return history_count;
+}
+
+const char* GetZoneName(Zone zone) {
+    switch (zone) {
+        case Zone::kInput:
+            return "INPUT";
+        case Zone::kSimulation:
+            return "SIMULATION";
+        case Zone::kBoardUpdate:
+            return "BOARD UPDATE";
+        case Zone::kLineClear:
+            return "LINE CLEAR";
+        case Zone::kRender:
+            return "RENDER";
+        case Zone::kPlayerDraw:
+            return "PLAYER DRAW";
+        case Zone::kPresent:
+            return "PRESENT";
+        default:
+            return "";
+    }
+}
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "trace.h"
+
+namespace game::profiler {
+
+enum class Zone {
+    kInput, kSimulation, kBoardUpdate, kLineClear, kRender, kPlayerDraw, kPresent, kNumOfZones
+};
+
+constexpr size_t kZoneCount = static_cast<size_t>(Zone::kNumOfZones);
+constexpr size_t kHistorySize = 240;
+// Zones timed per player are kept for this many players, later ones count
+// towards the last.
+constexpr size_t kMaxPlayers = 256;
+constexpr size_t kNoPlayer = SIZE_MAX;
+
+struct FrameStats {
+    uint64_t frame_ns;
+    std::array<uint64_t, kZoneCount> zone_ns;
+    std::array<uint32_t, kZoneCount> zone_calls;
+    // Player that spent the most time in each zone, kNoPlayer for zones not
+    // timed per player.
+    std::array<size_t, kZoneCount> slowest_player;
+    std::array<uint64_t, kZoneCount> slowest_player_ns;
+    uint32_t draw_calls;
+    size_t allocations;
+};
+
+class ScopedZone {
+public:
+    explicit ScopedZone(Zone zone, size_t player = kNoPlayer);
+    ScopedZone(const ScopedZone& other) = delete;
+    ScopedZone& operator=(const ScopedZone& other) = delete;
+    ~ScopedZone();
+
+private:
+    Zone zone_;
+    size_t player_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+void AddDrawCalls(uint32_t count);
+
+// Closes the current frame: moves the accumulated zone timings, draw calls
+// and allocations into the history and starts a new frame.
+void EndFrame();
+
+// Stats of a finished frame, age 0 is the most recent one.
+const FrameStats& GetFrame(size_t age);
+size_t GetFrameCount();
+const char* GetZoneName(Zone zone);
+
+}
+
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+// PROFILE_PLAYER_ZONE also keeps the zone's time per player index.
+#ifdef TETRIS_PROFILER
+#define PROFILE_ZONE(zone) ::game::profiler::ScopedZone PROFILER_CONCAT(profile_zone_, __LINE__){zone}
+#define PROFILE_PLAYER_ZONE(zone, player) \
+    ::game::profiler::ScopedZone PROFILER_CONCAT(profile_zone_, __LINE__){zone, player}
+#define PROFILE_DRAW_CALLS(count) ::game::profiler::AddDrawCalls(count)
+#define PROFILE_FRAME_END() ::game::profiler::EndFrame()
+#elif defined(TETRIS_TRACE)
+#define PROFILE_ZONE(zone) TRACE_SCOPE(::game::profiler::GetZoneName(zone))
+#define PROFILE_PLAYER_ZONE(zone, player) TRACE_SCOPE(::game::profiler::GetZoneName(zone))
+#define PROFILE_DRAW_CALLS(count) ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#else
+#define PROFILE_ZONE(zone) ((void)0)
+#define PROFILE_PLAYER_ZONE(zone, player) ((void)0)
+#define PROFILE_DRAW_CALLS(count) ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#endif
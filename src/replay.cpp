@@ -0,0 +1,466 @@
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include "replay.h"
+#include "varint.h"
+
+namespace game {
+
+namespace {
+
+constexpr uint8_t kMagic[4] = {'T', 'R', 'P', 'L'};
+constexpr uint8_t kVersion = 5;
+constexpr size_t kTrailerSize = 8;
+
+// Update symbols combine the move with how its timestamp is stored: the same
+// time as the previous update, the previous interval repeated, or a new
+// interval stored as a varint difference from the previous one.
+constexpr uint8_t kTimeClassCount = 3;
+constexpr uint8_t kSameTime = 0;
+constexpr uint8_t kSameStep = 1;
+constexpr uint8_t kNewStep = 2;
+constexpr uint8_t kMoveCount = static_cast<uint8_t>(MoveType::kNone) + 1;
+constexpr uint8_t kGarbageSymbol = kMoveCount * kTimeClassCount;
+constexpr uint8_t kStartGameSymbol = kGarbageSymbol + 1;
+constexpr uint8_t kPlayGameSymbol = kGarbageSymbol + 2;
+constexpr uint8_t kGameOverSymbol = kGarbageSymbol + 3;
+constexpr size_t kSymbolCount = kGarbageSymbol + 4;
+// Code lengths are stored two per byte.
+constexpr size_t kCodeLengthBytes = (kSymbolCount + 1) / 2;
+constexpr int kMaxCodeLength = ReplayReader::kMaxCodeLength;
+
+using SymbolCounts = std::array<uint64_t, kSymbolCount>;
+using CodeLengths = std::array<uint8_t, kSymbolCount>;
+
+CodeLengths BuildCodeLengths(SymbolCounts counts) {
+    CodeLengths lengths{};
+    size_t used = std::count_if(counts.begin(), counts.end(), [](uint64_t count) { return count > 0; });
+    if (used == 1) {
+        lengths[std::find_if(counts.begin(), counts.end(), [](uint64_t count) { return count > 0; }) - counts.begin()] = 1;
+        return lengths;
+    }
+    while (used > 1) {
+        // Leaves are 0..kSymbolCount-1, merged nodes follow.
+        std::array<int, 2 * kSymbolCount> parent{};
+        using Node = std::pair<uint64_t, int>;
+        std::priority_queue<Node, std::vector<Node>, std::greater<>> queue;
+        for (size_t i = 0; i < kSymbolCount; ++i) {
+            if (counts[i] > 0) {
+                queue.emplace(counts[i], static_cast<int>(i));
+            }
+        }
+        int next = kSymbolCount;
+        while (queue.size() > 1) {
+            auto [a_count, a] = queue.top();
+            queue.pop();
+            auto [b_count, b] = queue.top();
+            queue.pop();
+            parent[a] = next;
+            parent[b] = next;
+            queue.emplace(a_count + b_count, next++);
+        }
+        const int root = next - 1;
+        int longest = 0;
+        for (size_t i = 0; i < kSymbolCount; ++i) {
+            if (counts[i] == 0) {
+                continue;
+            }
+            int depth = 0;
+            for (int node = static_cast<int>(i); node != root; node = parent[node]) {
+                ++depth;
+            }
+            lengths[i] = static_cast<uint8_t>(depth);
+            longest = std::max(longest, depth);
+        }
+        if (longest <= kMaxCodeLength) {
+            break;
+        }
+        // Flatten the distribution until the longest code fits.
+        for (auto& count : counts) {
+            count = count == 0 ? 0 : (count + 1) / 2;
+        }
+        lengths.fill(0);
+    }
+    return lengths;
+}
+
+// Canonical codes: shorter codes first, ties by symbol.
+std::array<uint16_t, kSymbolCount> AssignCodes(const CodeLengths& lengths) {
+    std::array<uint16_t, kSymbolCount> codes{};
+    uint16_t code = 0;
+    for (int length = 1; length <= kMaxCodeLength; ++length) {
+        for (size_t i = 0; i < kSymbolCount; ++i) {
+            if (lengths[i] == length) {
+                codes[i] = code++;
+            }
+        }
+        code <<= 1;
+    }
+    return codes;
+}
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    void Put(uint16_t code, uint8_t length) {
+        for (int bit = length - 1; bit >= 0; --bit) {
+            this->byte_ = static_cast<uint8_t>((this->byte_ << 1) | ((code >> bit) & 1));
+            if (++this->bits_ == 8) {
+                this->out_.push_back(this->byte_);
+                this->byte_ = 0;
+                this->bits_ = 0;
+            }
+        }
+    }
+
+    void Flush() {
+        if (this->bits_ > 0) {
+            this->out_.push_back(static_cast<uint8_t>(this->byte_ << (8 - this->bits_)));
+            this->byte_ = 0;
+            this->bits_ = 0;
+        }
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+    uint8_t byte_ = 0;
+    int bits_ = 0;
+};
+
+void PutU64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+uint64_t GetU64(std::span<const uint8_t> in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+}
+
+void ReplayWriter::Begin(const ReplayHeader& header) {
+    this->recording_ = true;
+    this->bytes_.assign(std::begin(kMagic), std::end(kMagic));
+    this->bytes_.push_back(kVersion);
+    PutVarint(this->bytes_, header.seed);
+    PutVarint(this->bytes_, header.start_level);
+    this->bytes_.push_back(header.width);
+    this->bytes_.push_back(header.height);
+    this->bytes_.push_back(static_cast<uint8_t>(header.timing));
+    this->pending_.clear();
+    this->pending_.reserve(kBlockEvents);
+    this->checkpoints_.clear();
+    this->event_count_ = 0;
+    this->last_time_ns_ = 0;
+    this->last_step_ns_ = 0;
+}
+
+void ReplayWriter::Record(const ReplayEvent& event) {
+    this->pending_.push_back(event);
+    if (this->pending_.size() == kBlockEvents) {
+        this->FlushBlock();
+    }
+}
+
+bool ReplayWriter::IsRecording() const {
+    return this->recording_;
+}
+
+std::vector<uint8_t> ReplayWriter::Finish() {
+    this->FlushBlock();
+    const uint64_t index_offset = this->bytes_.size();
+    PutVarint(this->bytes_, this->event_count_);
+    PutVarint(this->bytes_, this->checkpoints_.size());
+    ReplayCheckpoint previous{};
+    for (const auto& checkpoint : this->checkpoints_) {
+        PutVarint(this->bytes_, checkpoint.event - previous.event);
+        PutVarint(this->bytes_, checkpoint.time_ns - previous.time_ns);
+        PutVarint(this->bytes_, checkpoint.offset - previous.offset);
+        previous = checkpoint;
+    }
+    PutU64(this->bytes_, index_offset);
+    this->recording_ = false;
+    return std::move(this->bytes_);
+}
+
+void ReplayWriter::FlushBlock() {
+    if (this->pending_.empty()) {
+        return;
+    }
+    this->checkpoints_.push_back(ReplayCheckpoint{this->event_count_, this->last_time_ns_, this->bytes_.size()});
+    PutVarint(this->bytes_, this->pending_.size());
+    PutVarint(this->bytes_, this->last_time_ns_);
+    PutVarint(this->bytes_, this->last_step_ns_);
+
+    // Symbols and their varint extras, in event order.
+    std::vector<uint8_t> symbols;
+    std::vector<uint8_t> extras;
+    symbols.reserve(this->pending_.size());
+    SymbolCounts counts{};
+    for (const auto& event : this->pending_) {
+        uint8_t symbol = 0;
+        switch (event.type) {
+            case ReplayEvent::Type::kUpdate: {
+                uint64_t time_ns = std::max(event.time_ns, this->last_time_ns_);
+                uint64_t step_ns = time_ns - this->last_time_ns_;
+                uint8_t time_class = kNewStep;
+                if (step_ns == 0) {
+                    time_class = kSameTime;
+                } else if (step_ns == this->last_step_ns_) {
+                    time_class = kSameStep;
+                } else {
+                    PutVarint(extras, ZigZag(static_cast<int64_t>(step_ns - this->last_step_ns_)));
+                    this->last_step_ns_ = step_ns;
+                }
+                this->last_time_ns_ = time_ns;
+                symbol = static_cast<uint8_t>(static_cast<uint8_t>(event.move) * kTimeClassCount + time_class);
+                break;
+            }
+            case ReplayEvent::Type::kGarbage:
+                symbol = kGarbageSymbol;
+                PutVarint(extras, event.lines);
+                break;
+            case ReplayEvent::Type::kStartGame:
+                symbol = kStartGameSymbol;
+                break;
+            case ReplayEvent::Type::kPlayGame:
+                symbol = kPlayGameSymbol;
+                break;
+            case ReplayEvent::Type::kGameOver:
+                symbol = kGameOverSymbol;
+                break;
+        }
+        symbols.push_back(symbol);
+        ++counts[symbol];
+    }
+
+    const CodeLengths lengths = BuildCodeLengths(counts);
+    const auto codes = AssignCodes(lengths);
+    for (size_t i = 0; i < kCodeLengthBytes; ++i) {
+        uint8_t high = lengths[2 * i];
+        uint8_t low = 2 * i + 1 < kSymbolCount ? lengths[2 * i + 1] : 0;
+        this->bytes_.push_back(static_cast<uint8_t>(high << 4 | low));
+    }
+    std::vector<uint8_t> bits;
+    BitWriter writer{bits};
+    for (auto symbol : symbols) {
+        writer.Put(codes[symbol], lengths[symbol]);
+    }
+    writer.Flush();
+    PutVarint(this->bytes_, bits.size());
+    PutVarint(this->bytes_, extras.size());
+    this->bytes_.insert(this->bytes_.end(), bits.begin(), bits.end());
+    this->bytes_.insert(this->bytes_.end(), extras.begin(), extras.end());
+
+    this->event_count_ += this->pending_.size();
+    this->pending_.clear();
+}
+
+bool ReplayReader::Open(std::span<const uint8_t> data) {
+    this->data_ = data;
+    this->checkpoints_.clear();
+    if (data.size() < sizeof(kMagic) + 1 + kTrailerSize ||
+        std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0 || data[sizeof(kMagic)] != kVersion) {
+        return false;
+    }
+    size_t offset = sizeof(kMagic) + 1;
+    uint64_t seed = 0;
+    uint64_t start_level = 0;
+    if (!GetVarint(data, offset, seed) || !GetVarint(data, offset, start_level) || offset + 3 > data.size() ||
+        data[offset + 2] > static_cast<uint8_t>(TimingModel::kNesFrames)) {
+        return false;
+    }
+    this->header_ = ReplayHeader{static_cast<uint32_t>(seed), static_cast<uint32_t>(start_level),
+                                 data[offset], data[offset + 1], static_cast<TimingModel>(data[offset + 2])};
+
+    const uint64_t index_offset = GetU64(data.subspan(data.size() - kTrailerSize));
+    if (index_offset < offset + 3 || index_offset > data.size() - kTrailerSize) {
+        return false;
+    }
+    this->blocks_end_ = index_offset;
+    auto index = data.first(data.size() - kTrailerSize);
+    size_t position = index_offset;
+    uint64_t count = 0;
+    if (!GetVarint(index, position, this->event_count_) || !GetVarint(index, position, count)) {
+        return false;
+    }
+    ReplayCheckpoint checkpoint{};
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t event = 0;
+        uint64_t time_ns = 0;
+        uint64_t block_offset = 0;
+        if (!GetVarint(index, position, event) || !GetVarint(index, position, time_ns) ||
+            !GetVarint(index, position, block_offset)) {
+            return false;
+        }
+        checkpoint.event += event;
+        checkpoint.time_ns += time_ns;
+        checkpoint.offset += block_offset;
+        if (checkpoint.offset >= this->blocks_end_) {
+            return false;
+        }
+        this->checkpoints_.push_back(checkpoint);
+    }
+    this->Seek(0);
+    return true;
+}
+
+const ReplayHeader& ReplayReader::GetHeader() const {
+    return this->header_;
+}
+
+uint64_t ReplayReader::GetEventCount() const {
+    return this->event_count_;
+}
+
+std::span<const ReplayCheckpoint> ReplayReader::GetCheckpoints() const {
+    return this->checkpoints_;
+}
+
+uint64_t ReplayReader::Seek(uint64_t event) {
+    auto after = std::upper_bound(this->checkpoints_.begin(), this->checkpoints_.end(), event,
+                                  [](uint64_t value, const ReplayCheckpoint& checkpoint) {
+                                      return value < checkpoint.event;
+                                  });
+    this->block_remaining_ = 0;
+    if (after == this->checkpoints_.begin()) {
+        this->next_block_ = this->blocks_end_;
+        this->event_index_ = 0;
+        return 0;
+    }
+    const auto& checkpoint = *(after - 1);
+    this->next_block_ = checkpoint.offset;
+    this->event_index_ = checkpoint.event;
+    return checkpoint.event;
+}
+
+bool ReplayReader::Next(ReplayEvent& event) {
+    if (this->block_remaining_ == 0) {
+        if (this->next_block_ >= this->blocks_end_ || !this->OpenBlock(this->next_block_)) {
+            return false;
+        }
+    }
+    uint8_t symbol = 0;
+    if (!this->DecodeSymbol(symbol)) {
+        return false;
+    }
+    auto extras = this->data_.first(this->block_end_);
+    event = ReplayEvent{};
+    if (symbol < kGarbageSymbol) {
+        event.type = ReplayEvent::Type::kUpdate;
+        event.move = static_cast<MoveType>(symbol / kTimeClassCount);
+        switch (symbol % kTimeClassCount) {
+            case kSameTime:
+                break;
+            case kSameStep:
+                this->time_ns_ += this->step_ns_;
+                break;
+            case kNewStep: {
+                uint64_t difference = 0;
+                if (!GetVarint(extras, this->extras_offset_, difference)) {
+                    return false;
+                }
+                this->step_ns_ += static_cast<uint64_t>(UnZigZag(difference));
+                this->time_ns_ += this->step_ns_;
+                break;
+            }
+        }
+        event.time_ns = this->time_ns_;
+    } else if (symbol == kGarbageSymbol) {
+        uint64_t lines = 0;
+        if (!GetVarint(extras, this->extras_offset_, lines) || lines > UINT8_MAX) {
+            return false;
+        }
+        event.type = ReplayEvent::Type::kGarbage;
+        event.lines = static_cast<uint8_t>(lines);
+    } else if (symbol == kStartGameSymbol) {
+        event.type = ReplayEvent::Type::kStartGame;
+    } else if (symbol == kPlayGameSymbol) {
+        event.type = ReplayEvent::Type::kPlayGame;
+    } else {
+        event.type = ReplayEvent::Type::kGameOver;
+    }
+    --this->block_remaining_;
+    ++this->event_index_;
+    return true;
+}
+
+bool ReplayReader::OpenBlock(size_t offset) {
+    auto blocks = this->data_.first(this->blocks_end_);
+    uint64_t count = 0;
+    uint64_t bits_size = 0;
+    uint64_t extras_size = 0;
+    if (!GetVarint(blocks, offset, count) || count == 0 || !GetVarint(blocks, offset, this->time_ns_) ||
+        !GetVarint(blocks, offset, this->step_ns_) || offset + kCodeLengthBytes > blocks.size()) {
+        return false;
+    }
+
+    CodeLengths lengths{};
+    for (size_t i = 0; i < kSymbolCount; ++i) {
+        uint8_t byte = blocks[offset + i / 2];
+        lengths[i] = i % 2 == 0 ? byte >> 4 : byte & 0x0F;
+    }
+    offset += kCodeLengthBytes;
+    // Canonical code tables: codes per length, symbols ordered by code.
+    this->code_counts_.fill(0);
+    this->code_symbols_.clear();
+    for (int length = 1; length <= kMaxCodeLength; ++length) {
+        for (size_t i = 0; i < kSymbolCount; ++i) {
+            if (lengths[i] == length) {
+                ++this->code_counts_[length];
+                this->code_symbols_.push_back(static_cast<uint8_t>(i));
+            }
+        }
+    }
+    int64_t unused = 1;
+    for (int length = 1; length <= kMaxCodeLength; ++length) {
+        unused = unused * 2 - this->code_counts_[length];
+        if (unused < 0) {
+            return false;
+        }
+    }
+
+    if (!GetVarint(blocks, offset, bits_size) || !GetVarint(blocks, offset, extras_size) ||
+        bits_size > blocks.size() - offset || extras_size > blocks.size() - offset - bits_size) {
+        return false;
+    }
+    this->bit_offset_ = offset * 8;
+    this->bits_end_ = (offset + bits_size) * 8;
+    this->extras_offset_ = offset + bits_size;
+    this->block_end_ = this->extras_offset_ + extras_size;
+    this->next_block_ = this->block_end_;
+    this->block_remaining_ = count;
+    return true;
+}
+
+bool ReplayReader::DecodeSymbol(uint8_t& symbol) {
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (int length = 1; length <= kMaxCodeLength; ++length) {
+        if (this->bit_offset_ >= this->bits_end_) {
+            return false;
+        }
+        int bit = (this->data_[this->bit_offset_ / 8] >> (7 - this->bit_offset_ % 8)) & 1;
+        ++this->bit_offset_;
+        code |= bit;
+        int count = this->code_counts_[length];
+        if (code - first < count) {
+            symbol = this->code_symbols_[index + code - first];
+            return true;
+        }
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+    return false;
+}
+
+}
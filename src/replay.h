@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "common.h"
+
+namespace game {
+
+// Everything a board needs besides its inputs to replay a game: a board
+// reseeded with seed, started at start_level and set to timing reproduces the
+// game exactly.
+struct ReplayHeader {
+    uint32_t seed = 0;
+    uint32_t start_level = 0;
+    uint8_t width = 0;
+    uint8_t height = 0;
+    TimingModel timing = TimingModel::kRealTime;
+};
+
+// One call made on the board, in the order it was made.
+struct ReplayEvent {
+    enum class Type : uint8_t { kUpdate, kGarbage, kStartGame, kPlayGame, kGameOver };
+    Type type = Type::kUpdate;
+    // kUpdate only.
+    MoveType move = MoveType::kNone;
+    // Nanoseconds since the recording started, kUpdate only. Updates made in
+    // one tick share its time, so a new time starts a new tick.
+    uint64_t time_ns = 0;
+    // kGarbage only.
+    uint8_t lines = 0;
+};
+
+// Where decoding can start without reading the events before it.
+struct ReplayCheckpoint {
+    uint64_t event = 0;
+    uint64_t time_ns = 0;
+    uint64_t offset = 0;
+};
+
+// Compresses a board's input log. Events are grouped in blocks of
+// kBlockEvents; each block Huffman-codes its move and time-class symbols with
+// a code built from its own counts, and stores timestamps as varint
+// differences from the previous tick interval, so a steady 60 Hz tick costs a
+// bit or two. Every block starts a checkpoint listed in an index at the end of
+// the replay. Events are buffered for one block at a time, so recording does
+// not allocate per event.
+class ReplayWriter {
+public:
+    static constexpr size_t kBlockEvents = 4096;
+
+    void Begin(const ReplayHeader& header);
+    void Record(const ReplayEvent& event);
+    bool IsRecording() const;
+    // Encodes the last block and the index and returns the replay.
+    std::vector<uint8_t> Finish();
+
+private:
+    bool recording_ = false;
+    std::vector<uint8_t> bytes_;
+    std::vector<ReplayEvent> pending_;
+    std::vector<ReplayCheckpoint> checkpoints_;
+    uint64_t event_count_ = 0;
+    // Decoder state at the start of the pending block.
+    uint64_t last_time_ns_ = 0;
+    uint64_t last_step_ns_ = 0;
+
+    void FlushBlock();
+};
+
+// Decodes a replay, sequentially or from any checkpoint.
+class ReplayReader {
+public:
+    static constexpr int kMaxCodeLength = 15;
+
+    // Reads the header and the checkpoint index; false on malformed data.
+    // data must outlive the reader.
+    bool Open(std::span<const uint8_t> data);
+    const ReplayHeader& GetHeader() const;
+    uint64_t GetEventCount() const;
+    std::span<const ReplayCheckpoint> GetCheckpoints() const;
+    // Continues at the last checkpoint at or before event and returns the
+    // index of the event Next decodes.
+    uint64_t Seek(uint64_t event);
+    // False at the end of the replay or on corrupt data.
+    bool Next(ReplayEvent& event);
+
+private:
+    std::span<const uint8_t> data_;
+    ReplayHeader header_;
+    std::vector<ReplayCheckpoint> checkpoints_;
+    uint64_t event_count_ = 0;
+    size_t blocks_end_ = 0;
+    // Current block.
+    size_t next_block_ = 0;
+    size_t block_end_ = 0;
+    size_t extras_offset_ = 0;
+    size_t bit_offset_ = 0;
+    size_t bits_end_ = 0;
+    uint64_t block_remaining_ = 0;
+    uint64_t event_index_ = 0;
+    uint64_t time_ns_ = 0;
+    uint64_t step_ns_ = 0;
+    std::array<uint16_t, kMaxCodeLength + 1> code_counts_{};
+    std::vector<uint8_t> code_symbols_;
+
+    bool OpenBlock(size_t offset);
+    bool DecodeSymbol(uint8_t& symbol);
+};
+
+}
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include "save_catalog.h"
+
+namespace game {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+json EntryToJson(const SaveEntry& entry) {
+    return json{{"id", entry.id}, {"timestamp", entry.timestamp}, {"players", entry.players},
+                {"level", entry.level}, {"points", entry.points}, {"offset", entry.offset},
+                {"size", entry.size}};
+}
+
+SaveEntry EntryFromJson(const json& obj) {
+    SaveEntry entry;
+    entry.id = obj.at("id").get<uint64_t>();
+    entry.timestamp = obj.at("timestamp").get<int64_t>();
+    entry.players = obj.at("players").get<uint32_t>();
+    entry.level = obj.at("level").get<uint64_t>();
+    entry.points = obj.at("points").get<uint64_t>();
+    entry.offset = obj.at("offset").get<uint64_t>();
+    entry.size = obj.at("size").get<uint64_t>();
+    return entry;
+}
+
+}
+
+SaveCatalog::SaveCatalog(fs::path directory)
+    : directory_(std::move(directory)) {}
+
+bool SaveCatalog::Open() {
+    this->entries_.clear();
+    this->next_id_ = 1;
+    this->index_needs_newline_ = false;
+    this->opened_ = false;
+    std::ifstream index(this->directory_ / kIndexName_, std::ios::binary);
+    if (!index) {
+        this->opened_ = !fs::exists(this->directory_ / kIndexName_);
+        return this->opened_;
+    }
+    std::string line;
+    while (std::getline(index, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        try {
+            SaveEntry entry = EntryFromJson(json::parse(line));
+            this->next_id_ = std::max(this->next_id_, entry.id + 1);
+            this->entries_.push_back(entry);
+        }
+        catch (const json::exception& e) {
+            std::cerr << "Skipping corrupt save index entry: " << e.what() << std::endl;
+        }
+    }
+    // A crash during a save can leave the last line unterminated; the next
+    // entry must not be appended to it.
+    index.clear();
+    index.seekg(0, std::ios::end);
+    if (index.tellg() > 0) {
+        char last = '\n';
+        index.seekg(-1, std::ios::end);
+        index.get(last);
+        this->index_needs_newline_ = last != '\n';
+    }
+    this->opened_ = true;
+    return true;
+}
+
+const std::vector<SaveEntry>& SaveCatalog::GetEntries() const {
+    return this->entries_;
+}
+
+std::optional<SaveEntry> SaveCatalog::Add(const json& doc, uint32_t players, uint64_t level, uint64_t points) {
+    if (!this->opened_ && !this->Open()) {
+        return std::nullopt;
+    }
+    std::error_code error;
+    fs::create_directories(this->directory_, error);
+    if (error) {
+        std::cerr << "Failed to create save directory: " << error.message() << std::endl;
+        return std::nullopt;
+    }
+
+    SaveEntry entry;
+    entry.id = this->next_id_;
+    entry.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    entry.players = players;
+    entry.level = level;
+    entry.points = points;
+
+    // The document goes to the archive first, so the index never points past
+    // its end.
+    std::string body = doc.dump();
+    std::ofstream archive(this->GetArchivePath(), std::ios::binary | std::ios::app);
+    if (!archive) {
+        std::cerr << "Failed to open save archive: " << this->GetArchivePath() << std::endl;
+        return std::nullopt;
+    }
+    archive.seekp(0, std::ios::end);
+    entry.offset = static_cast<uint64_t>(archive.tellp());
+    entry.size = body.size();
+    archive << body << '\n';
+    archive.close();
+    if (!archive) {
+        std::cerr << "Failed to write save archive: " << this->GetArchivePath() << std::endl;
+        return std::nullopt;
+    }
+
+    std::ofstream index(this->directory_ / kIndexName_, std::ios::app);
+    if (this->index_needs_newline_) {
+        index << '\n';
+    }
+    index << EntryToJson(entry).dump() << '\n';
+    index.close();
+    if (!index) {
+        std::cerr << "Failed to write save index" << std::endl;
+        return std::nullopt;
+    }
+
+    ++this->next_id_;
+    this->index_needs_newline_ = false;
+    this->entries_.push_back(entry);
+    return entry;
+}
+
+bool SaveCatalog::OpenDocument(const SaveEntry& entry, std::ifstream& archive) const {
+    archive.open(this->GetArchivePath(), std::ios::binary);
+    if (!archive) {
+        std::cerr << "Could not open save archive: " << this->GetArchivePath() << std::endl;
+        return false;
+    }
+    archive.seekg(static_cast<std::streamoff>(entry.offset));
+    if (!archive) {
+        std::cerr << "Save " << entry.id << " is missing from the archive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+fs::path SaveCatalog::GetArchivePath() const {
+    return this->directory_ / kArchiveName_;
+}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+#include "i_save_service.h"
+
+namespace game {
+
+// Metadata of one save, enough to list it without reading the save itself.
+struct SaveEntry {
+    uint64_t id = 0;
+    // Seconds since the Unix epoch.
+    int64_t timestamp = 0;
+    uint32_t players = 0;
+    uint64_t level = 0;
+    uint64_t points = 0;
+    // Location of the save document in the archive.
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+// Saves live in one directory: every save document is appended to an archive
+// file and described by one line of an append-only index. Adding a save is two
+// appends, and listing reads only the index.
+class SaveCatalog {
+public:
+    explicit SaveCatalog(std::filesystem::path directory);
+    // Reads the index, again on every call so saves written by another
+    // process show up. A missing index is an empty catalog; corrupt lines,
+    // such as one cut short by a crash during a save, are skipped.
+    bool Open();
+    // Entries in the order they were saved.
+    const std::vector<SaveEntry>& GetEntries() const;
+    // Appends doc to the archive and records it under the next id. Opens the
+    // index and creates the directory on first use; later calls only append.
+    std::optional<SaveEntry> Add(const json& doc, uint32_t players, uint64_t level, uint64_t points);
+    // Opens the archive positioned at the document of entry, for streaming.
+    bool OpenDocument(const SaveEntry& entry, std::ifstream& archive) const;
+    std::filesystem::path GetArchivePath() const;
+
+private:
+    static constexpr const char* kIndexName_ = "index.jsonl";
+    static constexpr const char* kArchiveName_ = "archive.jsonl";
+    std::filesystem::path directory_;
+    std::vector<SaveEntry> entries_;
+    uint64_t next_id_ = 1;
+    bool index_needs_newline_ = false;
+    bool opened_ = false;
+};
+
+}
@@ -0,0 +1,155 @@
+#include <charconv>
+#include <iostream>
+#include "save_loader.h"
+
+namespace game {
+
+namespace {
+
+// Depths of the save document: {"Player0": {"level": 3, "board": [[0, 1, ...], ...]}}
+constexpr size_t kDocumentDepth = 1;
+constexpr size_t kPlayerDepth = 2;
+constexpr size_t kBoardDepth = 3;
+constexpr size_t kRowDepth = 4;
+
+class SaveSaxHandler : public nlohmann::json_sax<json> {
+public:
+    explicit SaveSaxHandler(std::span<IStreamLoadable* const> players)
+        : players_(players) {}
+
+    bool null() override {
+        return true;
+    }
+
+    bool boolean(bool) override {
+        return true;
+    }
+
+    bool number_integer(number_integer_t value) override {
+        if (value < 0) {
+            return this->depth_ != kPlayerDepth && this->depth_ != kRowDepth;
+        }
+        return this->Number(static_cast<uint64_t>(value));
+    }
+
+    bool number_unsigned(number_unsigned_t value) override {
+        return this->Number(value);
+    }
+
+    bool number_float(number_float_t, const string_t&) override {
+        return true;
+    }
+
+    bool string(string_t&) override {
+        return true;
+    }
+
+    bool binary(binary_t&) override {
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        ++this->depth_;
+        if (this->depth_ == kPlayerDepth && this->player_ != nullptr) {
+            this->player_->BeginLoad();
+            this->rows_ = 0;
+            this->columns_ = 0;
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        bool loaded = true;
+        if (this->depth_ == kPlayerDepth && this->player_ != nullptr) {
+            loaded = this->player_->EndLoad(this->rows_, this->columns_);
+            this->player_ = nullptr;
+        }
+        --this->depth_;
+        return loaded;
+    }
+
+    bool start_array(std::size_t) override {
+        ++this->depth_;
+        if (this->depth_ == kRowDepth && this->InBoard()) {
+            this->column_ = 0;
+        }
+        return true;
+    }
+
+    bool end_array() override {
+        if (this->depth_ == kRowDepth && this->InBoard()) {
+            // Every row must be as wide as the first.
+            if (this->rows_ > 0 && this->column_ != this->columns_) {
+                return false;
+            }
+            this->columns_ = this->column_;
+            ++this->rows_;
+        }
+        --this->depth_;
+        return true;
+    }
+
+    bool key(string_t& key) override {
+        if (this->depth_ == kDocumentDepth) {
+            this->player_ = this->FindPlayer(key);
+        } else if (this->depth_ == kPlayerDepth) {
+            this->key_ = key;
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& e) override {
+        std::cerr << "Parse error at byte " << position << ": " << e.what() << std::endl;
+        return false;
+    }
+
+private:
+    std::span<IStreamLoadable* const> players_;
+    IStreamLoadable* player_ = nullptr;
+    size_t depth_ = 0;
+    std::string key_;
+    size_t rows_ = 0;
+    size_t columns_ = 0;
+    size_t column_ = 0;
+
+    IStreamLoadable* FindPlayer(std::string_view key) const {
+        constexpr std::string_view prefix = "Player";
+        if (!key.starts_with(prefix)) {
+            return nullptr;
+        }
+        size_t index = 0;
+        auto digits = key.substr(prefix.size());
+        auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), index);
+        if (error != std::errc{} || end != digits.data() + digits.size() || index >= this->players_.size()) {
+            return nullptr;
+        }
+        return this->players_[index];
+    }
+
+    bool InBoard() const {
+        return this->player_ != nullptr && this->key_ == "board";
+    }
+
+    bool Number(uint64_t value) {
+        if (this->player_ == nullptr) {
+            return true;
+        }
+        if (this->depth_ == kPlayerDepth) {
+            return this->player_->LoadValue(this->key_, value);
+        }
+        if (this->depth_ == kRowDepth && this->InBoard()) {
+            return value <= UINT8_MAX &&
+                   this->player_->LoadCell(this->rows_, this->column_++, static_cast<uint8_t>(value));
+        }
+        return true;
+    }
+};
+
+}
+
+bool StreamSaveDocument(std::istream& input, std::span<IStreamLoadable* const> players) {
+    SaveSaxHandler handler{players};
+    return json::sax_parse(input, &handler, json::input_format_t::json, false);
+}
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <istream>
+#include <span>
+#include "i_save_service.h"
+
+namespace game {
+
+// Parses one save document from input with the SAX interface and hands each
+// "Player<i>" object to players[i] as its values arrive; players missing from
+// the span are skipped. No document is built, so memory use does not grow with
+// the save. Reading stops at the end of the document, which may be followed by
+// more data, such as the next save in an archive.
+bool StreamSaveDocument(std::istream& input, std::span<IStreamLoadable* const> players);
+
+}
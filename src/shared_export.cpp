@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include "shared_export.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define TETRIS_HAS_SHM 1
+#endif
+
+namespace game {
+
+namespace {
+
+constexpr int kReadAttempts = 64;
+
+size_t SlotsOffset() {
+    return (sizeof(SharedExportHeader) + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+}
+
+size_t SegmentSize(size_t board_count) {
+    return SlotsOffset() + board_count * sizeof(SharedBoardSlot);
+}
+
+std::string SegmentName(const std::string& name) {
+    return name.starts_with('/') ? name : "/" + name;
+}
+
+}
+
+#ifdef TETRIS_HAS_SHM
+
+SharedBoardExport::SharedBoardExport(const std::string& name, size_t board_count)
+    : name_(SegmentName(name)), size_(SegmentSize(board_count)), board_count_(board_count) {
+    int fd = shm_open(this->name_.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "shm_open");
+    }
+    if (ftruncate(fd, static_cast<off_t>(this->size_)) < 0) {
+        int error = errno;
+        close(fd);
+        shm_unlink(this->name_.c_str());
+        throw std::system_error(error, std::generic_category(), "ftruncate");
+    }
+    this->memory_ = mmap(nullptr, this->size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (this->memory_ == MAP_FAILED) {
+        shm_unlink(this->name_.c_str());
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+
+    // The mapping starts zeroed, a valid header is written last.
+    auto* bytes = static_cast<uint8_t*>(this->memory_);
+    this->slots_ = reinterpret_cast<SharedBoardSlot*>(bytes + SlotsOffset());
+    for (size_t i = 0; i < board_count; ++i) {
+        new (&this->slots_[i]) SharedBoardSlot{};
+    }
+    auto* header = new (this->memory_) SharedExportHeader{};
+    header->version = SharedExportHeader::kVersion;
+    header->board_count = static_cast<uint32_t>(board_count);
+    header->slot_size = sizeof(SharedBoardSlot);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = SharedExportHeader::kMagic;
+}
+
+SharedBoardExport::~SharedBoardExport() {
+    munmap(this->memory_, this->size_);
+    shm_unlink(this->name_.c_str());
+}
+
+SharedBoardReader::SharedBoardReader(const std::string& name) {
+    std::string segment = SegmentName(name);
+    int fd = shm_open(segment.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "shm_open");
+    }
+    SharedExportHeader header{};
+    if (pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        header.magic != SharedExportHeader::kMagic || header.version != SharedExportHeader::kVersion ||
+        header.slot_size != sizeof(SharedBoardSlot)) {
+        close(fd);
+        throw std::runtime_error("shared export " + segment + " has an unknown layout");
+    }
+    this->board_count_ = header.board_count;
+    this->size_ = SegmentSize(this->board_count_);
+    this->memory_ = mmap(nullptr, this->size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (this->memory_ == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    this->slots_ = reinterpret_cast<const SharedBoardSlot*>(static_cast<const uint8_t*>(this->memory_) + SlotsOffset());
+}
+
+SharedBoardReader::~SharedBoardReader() {
+    munmap(this->memory_, this->size_);
+}
+
+#else
+
+SharedBoardExport::SharedBoardExport(const std::string&, size_t) {
+    throw std::runtime_error("shared-memory export needs POSIX shared memory");
+}
+
+SharedBoardExport::~SharedBoardExport() = default;
+
+SharedBoardReader::SharedBoardReader(const std::string&) {
+    throw std::runtime_error("shared-memory export needs POSIX shared memory");
+}
+
+SharedBoardReader::~SharedBoardReader() = default;
+
+#endif
+
+void SharedBoardExport::Publish(size_t index, const IBoard& board, uint64_t tick) {
+    if (index >= this->board_count_) {
+        return;
+    }
+    SharedBoardState state{};
+    auto cells = board.GetBoard();
+    state.tick = tick;
+    state.points = board.GetPoints();
+    state.cleared_lines = board.GetClearedLineCount();
+    state.level = board.GetLevel();
+    state.piece_row = static_cast<int16_t>(board.GetPieceRowPosition(PieceType::kActualPiece));
+    state.piece_col = static_cast<int16_t>(board.GetPieceColumnPosition(PieceType::kActualPiece));
+    state.piece_shape = static_cast<uint8_t>(board.GetPieceShape(PieceType::kActualPiece));
+    state.piece_rotation = board.GetPieceRotation(PieceType::kActualPiece);
+    state.next_shape = static_cast<uint8_t>(board.GetPieceShape(PieceType::kNextPiece));
+    state.next_rotation = board.GetPieceRotation(PieceType::kNextPiece);
+    state.width = board.GetBoardWidth();
+    state.height = static_cast<uint8_t>(std::min<size_t>(board.GetBoardHeight(), SharedBoardState::kMaxCells / state.width));
+    state.phase = static_cast<uint8_t>(board.GetActualGamePhase());
+    state.preview_count = static_cast<uint8_t>(std::min(board.GetPreviewDepth(), state.preview.size()));
+    for (size_t i = 0; i < state.preview_count; ++i) {
+        state.preview[i] = static_cast<uint8_t>(board.GetPreviewShape(i));
+    }
+    state.held_shape = static_cast<uint8_t>(board.GetHeldShape().value_or(Shape::kNumOfShapes));
+    std::copy_n(cells.begin(), state.width * state.height, state.cells.begin());
+
+    std::array<uint64_t, SharedBoardSlot::kWords> words{};
+    std::memcpy(words.data(), &state, sizeof(state));
+    auto& slot = this->slots_[index];
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < words.size(); ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+size_t SharedBoardReader::GetBoardCount() const {
+    return this->board_count_;
+}
+
+bool SharedBoardReader::Read(size_t index, SharedBoardState& state) const {
+    if (index >= this->board_count_) {
+        return false;
+    }
+    const auto& slot = this->slots_[index];
+    std::array<uint64_t, SharedBoardSlot::kWords> words;
+    for (int attempt = 0; attempt < kReadAttempts; ++attempt) {
+        uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        for (size_t i = 0; i < words.size(); ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == before) {
+            std::memcpy(&state, words.data(), sizeof(state));
+            return true;
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "i_board.h"
+#include "piece_queue.h"
+
+namespace game {
+
+// Board state as external monitors read it. Plain data, copied in and out of
+// shared memory as a whole.
+struct SharedBoardState {
+    static constexpr size_t kMaxCells = 1024;
+
+    uint64_t tick;
+    uint64_t points;
+    uint64_t cleared_lines;
+    uint64_t level;
+    int16_t piece_row;
+    int16_t piece_col;
+    uint8_t piece_shape;
+    uint8_t piece_rotation;
+    uint8_t next_shape;
+    uint8_t next_rotation;
+    // Zero until the board is first published.
+    uint8_t width;
+    // Rows beyond kMaxCells / width are not exported.
+    uint8_t height;
+    uint8_t phase;
+    // Queued shapes from the next piece on, preview_count of them.
+    uint8_t preview_count;
+    std::array<uint8_t, PieceQueue::kMaxPreview> preview;
+    // Shape::kNumOfShapes while the hold slot is empty.
+    uint8_t held_shape;
+    std::array<uint8_t, kMaxCells> cells;
+};
+
+// Layout of the shared-memory segment: a header followed by one slot per
+// board. Each slot is a seqlock, the writer never waits for readers.
+struct SharedExportHeader {
+    static constexpr uint32_t kMagic = 0x54455452; // "TETR"
+    static constexpr uint32_t kVersion = 2;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t board_count;
+    uint32_t slot_size;
+};
+
+struct alignas(kCacheLineSize) SharedBoardSlot {
+    static constexpr size_t kWords = (sizeof(SharedBoardState) + 7) / 8;
+
+    // Odd while the writer is updating the slot.
+    std::atomic<uint32_t> sequence;
+    // The state is copied word by word through relaxed atomics, so readers
+    // racing with the writer are well defined and simply retry.
+    std::array<std::atomic<uint64_t>, kWords> words;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "shared-memory seqlock needs address-free atomics");
+
+// Creates a POSIX shared-memory segment /name and publishes board states into
+// it. Each slot must have a single writer. Throws std::system_error when the
+// segment cannot be created and std::runtime_error on platforms without POSIX
+// shared memory.
+class SharedBoardExport {
+public:
+    SharedBoardExport(const std::string& name, size_t board_count);
+    SharedBoardExport(const SharedBoardExport& other) = delete;
+    SharedBoardExport& operator=(const SharedBoardExport& other) = delete;
+    // Unmaps and unlinks the segment.
+    ~SharedBoardExport();
+    void Publish(size_t index, const IBoard& board, uint64_t tick);
+
+private:
+    std::string name_;
+    size_t size_ = 0;
+    void* memory_ = nullptr;
+    SharedBoardSlot* slots_ = nullptr;
+    size_t board_count_ = 0;
+};
+
+// Maps an existing export read-only.
+class SharedBoardReader {
+public:
+    explicit SharedBoardReader(const std::string& name);
+    SharedBoardReader(const SharedBoardReader& other) = delete;
+    SharedBoardReader& operator=(const SharedBoardReader& other) = delete;
+    ~SharedBoardReader();
+    size_t GetBoardCount() const;
+    // Copies a consistent state of board index, false if the writer kept it
+    // busy for every attempt.
+    bool Read(size_t index, SharedBoardState& state) const;
+
+private:
+    size_t size_ = 0;
+    void* memory_ = nullptr;
+    const SharedBoardSlot* slots_ = nullptr;
+    size_t board_count_ = 0;
+};
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include "common.h"
+
+namespace game {
+
+// Bounded lock-free queue between exactly one producer and one consumer
+// thread. Push fails instead of blocking when the queue is full.
+template <typename T, size_t N>
+requires (N > 0 && (N & (N - 1)) == 0)
+class SpscQueue {
+public:
+    bool Push(const T& value) {
+        size_t tail = this->tail_.load(std::memory_order_relaxed);
+        if (tail - this->head_.load(std::memory_order_acquire) == N) {
+            return false;
+        }
+        this->items_[tail & (N - 1)] = value;
+        this->tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(T& value) {
+        size_t head = this->head_.load(std::memory_order_relaxed);
+        if (head == this->tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = this->items_[head & (N - 1)];
+        this->head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+    std::array<T, N> items_{};
+};
+
+}
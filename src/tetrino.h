@@ -2,27 +2,48 @@
 
 #include "common.h"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <memory>
 
 namespace game {
 
 using tetrino = uint8_t;
 
-class Tetrino {
-public:
-    struct TetrinoPiece {
-        std::shared_ptr<tetrino[]> shape;
-        uint16_t dim;
-    };
+constexpr size_t kMaxTetrinoCells = 16;
+constexpr size_t kShapeCount = static_cast<size_t>(Shape::kNumOfShapes);
+// Cell value of garbage rows, after the seven shape values.
+constexpr tetrino kGarbageCell = 8;
 
-    explicit Tetrino(Shape shape);
-    Tetrino(const Tetrino& other) = delete;
-    Tetrino& operator=(const Tetrino& other) = delete;
-    std::shared_ptr<TetrinoPiece> Get();
-
-private:
-    std::shared_ptr<TetrinoPiece> instance_;
+struct TetrinoPiece {
+    std::array<tetrino, kMaxTetrinoCells> shape;
+    uint16_t dim;
 };
 
+// Spawn orientation of every shape, indexed by Shape. Cells hold the color
+// index, row-major within a dim x dim box.
+inline constexpr std::array<TetrinoPiece, kShapeCount> kTetrinos{{
+        {{1, 1,
+          1, 1}, 2},
+        {{0, 0, 0, 0,
+          2, 2, 2, 2,
+          0, 0, 0, 0,
+          0, 0, 0, 0}, 4},
+        {{0, 0, 0,
+          3, 3, 3,
+          0, 3, 0}, 3},
+        {{0, 4, 4,
+          4, 4, 0,
+          0, 0, 0}, 3},
+        {{5, 5, 0,
+          0, 5, 5,
+          0, 0, 0}, 3},
+        {{0, 6, 0,
+          0, 6, 0,
+          0, 6, 6}, 3},
+        {{0, 7, 0,
+          0, 7, 0,
+          7, 7, 0}, 3}
+}};
+
 }
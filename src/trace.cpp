@@ -0,0 +1,184 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "trace.h"
+
+namespace game::trace {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Event {
+    const char* name;
+    uint64_t timestamp_ns;
+    int64_t arg;
+    char phase;
+};
+
+// One ring entry. The fields are relaxed atomics and sequence is a
+// per-slot seqlock: 0 while the owner writes the slot, otherwise the event's
+// position in the ring plus one. Flush may copy a slot the owner is
+// overwriting, and keeps it only if sequence did not change meanwhile.
+struct EventSlot {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> timestamp_ns{0};
+    std::atomic<int64_t> arg{0};
+    std::atomic<char> phase{0};
+};
+
+// Single producer ring. Only the owning thread writes, Flush reads the
+// published range and drops whatever was overwritten meanwhile.
+struct ThreadBuffer {
+    uint32_t id;
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> head{0};
+    std::array<EventSlot, kEventsPerThread> events{};
+};
+
+const Clock::time_point kEpoch = Clock::now();
+std::mutex registry_mutex;
+std::vector<std::shared_ptr<ThreadBuffer>> registry;
+
+ThreadBuffer* RegisterThread() {
+    auto buffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    buffer->id = static_cast<uint32_t>(registry.size() + 1);
+    registry.push_back(buffer);
+    return buffer.get();
+}
+
+ThreadBuffer& GetThreadBuffer() {
+    thread_local ThreadBuffer* buffer = RegisterThread();
+    return *buffer;
+}
+
+void Record(const char* name, char phase, int64_t arg) {
+    auto& buffer = GetThreadBuffer();
+    auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - kEpoch).count();
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    auto& slot = buffer.events[head % kEventsPerThread];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.timestamp_ns.store(static_cast<uint64_t>(timestamp), std::memory_order_relaxed);
+    slot.arg.store(arg, std::memory_order_relaxed);
+    slot.phase.store(phase, std::memory_order_relaxed);
+    slot.sequence.store(head + 1, std::memory_order_release);
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+// Copies the event at ring position index, false when the owner has
+// overwritten it or is writing it.
+bool ReadEvent(const ThreadBuffer& buffer, uint64_t index, Event& event) {
+    const auto& slot = buffer.events[index % kEventsPerThread];
+    if (slot.sequence.load(std::memory_order_acquire) != index + 1) {
+        return false;
+    }
+    event = Event{slot.name.load(std::memory_order_relaxed), slot.timestamp_ns.load(std::memory_order_relaxed),
+                  slot.arg.load(std::memory_order_relaxed), slot.phase.load(std::memory_order_relaxed)};
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == index + 1;
+}
+
+void WriteEvent(std::ofstream& ofs, bool& first, uint32_t tid, const Event& event) {
+    ofs << (first ? "\n" : ",\n");
+    first = false;
+    ofs << R"({"name":")" << event.name << R"(","ph":")" << event.phase
+        << R"(","ts":)" << static_cast<double>(event.timestamp_ns) / 1000.0
+        << R"(,"pid":1,"tid":)" << tid;
+    if (event.phase == 'i') {
+        ofs << R"(,"s":"t","args":{"value":)" << event.arg << "}";
+    }
+    ofs << "}";
+}
+
+}
+
+void Begin(const char* name) {
+    Record(name, 'B', 0);
+}
+
+void End(const char* name) {
+    Record(name, 'E', 0);
+}
+
+void Instant(const char* name, int64_t arg) {
+    Record(name, 'i', arg);
+}
+
+void SetThreadName(const char* name) {
+    GetThreadBuffer().name.store(name, std::memory_order_relaxed);
+}
+
+bool Flush(const std::string& path) {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        buffers = registry;
+    }
+
+    std::ofstream ofs(path);
+    if (!ofs) {
+        std::cerr << "Failed to create trace file: " << path << std::endl;
+        return false;
+    }
+
+    ofs << std::fixed << std::setprecision(3);
+    ofs << R"({"displayTimeUnit":"ms","traceEvents":[)";
+    bool first = true;
+    std::vector<Event> events;
+    for (const auto& buffer : buffers) {
+        if (auto name = buffer->name.load(std::memory_order_relaxed)) {
+            ofs << (first ? "\n" : ",\n");
+            first = false;
+            ofs << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->id
+                << R"(,"args":{"name":")" << name << R"("}})";
+        }
+
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t tail = head > kEventsPerThread ? head - kEventsPerThread : 0;
+        // Events the owner wrapped over while they were copied are dropped;
+        // a later event that survived is kept.
+        events.clear();
+        Event event{};
+        for (uint64_t i = tail; i < head; ++i) {
+            if (ReadEvent(*buffer, i, event)) {
+                events.push_back(event);
+            }
+            else {
+                events.clear();
+            }
+        }
+
+        int depth = 0;
+        for (size_t i = 0; i < events.size(); ++i) {
+            const auto& event = events[i];
+            if (event.phase == 'B') {
+                ++depth;
+            }
+            else if (event.phase == 'E') {
+                // The matching begin was overwritten by the ring.
+                if (depth == 0) {
+                    continue;
+                }
+                --depth;
+            }
+            WriteEvent(ofs, first, buffer->id, event);
+        }
+    }
+    ofs << "\n]}\n";
+    ofs.close();
+
+    std::cout << "Trace written: " << path << std::endl;
+    return true;
+}
+
+}
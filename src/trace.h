@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace game::trace {
+
+// Events are kept in a fixed ring per thread, older events are overwritten.
+constexpr size_t kEventsPerThread = size_t{1} << 16;
+
+void Begin(const char* name);
+void End(const char* name);
+void Instant(const char* name, int64_t arg);
+void SetThreadName(const char* name);
+
+// Writes the events of all threads as a Chrome trace-event JSON file, which
+// opens in chrome://tracing or Perfetto. Recording continues during a flush.
+bool Flush(const std::string& path);
+
+class ScopedEvent {
+public:
+    explicit ScopedEvent(const char* name) : name_(name) {
+        Begin(name);
+    }
+    ScopedEvent(const ScopedEvent& other) = delete;
+    ScopedEvent& operator=(const ScopedEvent& other) = delete;
+    ~ScopedEvent() {
+        End(this->name_);
+    }
+
+private:
+    const char* name_;
+};
+
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+// Names must be string literals or other strings with static storage.
+#ifdef TETRIS_TRACE
+#define TRACE_SCOPE(name) ::game::trace::ScopedEvent TRACE_CONCAT(trace_scope_, __LINE__){name}
+#define TRACE_INSTANT(name, arg) ::game::trace::Instant(name, static_cast<int64_t>(arg))
+#define TRACE_THREAD_NAME(name) ::game::trace::SetThreadName(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_INSTANT(name, arg) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace game {
+
+// Lock-free hand-off of the latest value from one producer thread to one
+// consumer thread. The producer fills GetWriteBuffer() and publishes it; the
+// consumer always reads the newest published value and neither side waits.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    // Only for relocating a buffer that no thread is using yet.
+    TripleBuffer(TripleBuffer&& other) noexcept
+        : buffers_(std::move(other.buffers_)),
+          middle_(other.middle_.load(std::memory_order_relaxed)),
+          write_(other.write_),
+          read_(other.read_) {}
+    TripleBuffer& operator=(TripleBuffer&& other) = delete;
+
+    // Producer side.
+    T& GetWriteBuffer() {
+        return this->buffers_[this->write_];
+    }
+
+    void Publish() {
+        uint8_t previous = this->middle_.exchange(this->write_ | kFreshBit, std::memory_order_acq_rel);
+        this->write_ = previous & kIndexMask;
+    }
+
+    // Consumer side. The reference stays valid until the next call.
+    const T& Read() {
+        if (this->middle_.load(std::memory_order_relaxed) & kFreshBit) {
+            uint8_t previous = this->middle_.exchange(this->read_, std::memory_order_acq_rel);
+            this->read_ = previous & kIndexMask;
+        }
+        return this->buffers_[this->read_];
+    }
+
+private:
+    static constexpr uint8_t kIndexMask = 3;
+    static constexpr uint8_t kFreshBit = 4;
+
+    std::array<T, 3> buffers_{};
+    // Index of the buffer between the two sides, kFreshBit marks it unread.
+    std::atomic<uint8_t> middle_{1};
+    uint8_t write_ = 0;
+    uint8_t read_ = 2;
+};
+
+}
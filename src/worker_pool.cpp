@@ -0,0 +1,68 @@
+#include "worker_pool.h"
+#include "trace.h"
+
+namespace game {
+
+WorkerPool::WorkerPool(size_t thread_count)
+    : start_barrier_(static_cast<std::ptrdiff_t>(thread_count > 0 ? thread_count : 1)),
+      done_barrier_(static_cast<std::ptrdiff_t>(thread_count > 0 ? thread_count : 1)) {
+    for (size_t i = 1; i < thread_count; ++i) {
+        this->threads_.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    if (this->threads_.empty()) {
+        return;
+    }
+    this->stop_ = true;
+    this->start_barrier_.arrive_and_wait();
+    for (auto& thread : this->threads_) {
+        thread.join();
+    }
+}
+
+size_t WorkerPool::GetThreadCount() const {
+    return this->threads_.size() + 1;
+}
+
+void WorkerPool::RunErased(size_t count, JobFn job, void* context) {
+    if (this->threads_.empty() || count < 2) {
+        for (size_t i = 0; i < count; ++i) {
+            job(context, i);
+        }
+        return;
+    }
+    // The barriers order these writes before the workers read them.
+    this->job_ = job;
+    this->job_context_ = context;
+    this->job_count_ = count;
+    this->next_index_.store(0, std::memory_order_relaxed);
+    this->start_barrier_.arrive_and_wait();
+    this->TakeIndices();
+    this->done_barrier_.arrive_and_wait();
+}
+
+void WorkerPool::WorkerLoop() {
+    TRACE_THREAD_NAME("worker");
+    while (true) {
+        this->start_barrier_.arrive_and_wait();
+        if (this->stop_) {
+            return;
+        }
+        this->TakeIndices();
+        this->done_barrier_.arrive_and_wait();
+    }
+}
+
+void WorkerPool::TakeIndices() {
+    while (true) {
+        size_t index = this->next_index_.fetch_add(1, std::memory_order_relaxed);
+        if (index >= this->job_count_) {
+            return;
+        }
+        this->job_(this->job_context_, index);
+    }
+}
+
+}
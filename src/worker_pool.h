@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace game {
+
+// Threads that live as long as the pool and run one job over the indices
+// [0, count) per call to Run. The calling thread takes part in the work and
+// Run returns once every index is done, so results can be read right after.
+class WorkerPool {
+public:
+    // thread_count includes the calling thread, 1 runs every job inline.
+    explicit WorkerPool(size_t thread_count);
+    WorkerPool(const WorkerPool& other) = delete;
+    WorkerPool& operator=(const WorkerPool& other) = delete;
+    ~WorkerPool();
+
+    template <typename Fn>
+    void Run(size_t count, Fn& job) {
+        this->RunErased(count, [](void* context, size_t index) {
+            (*static_cast<Fn*>(context))(index);
+        }, &job);
+    }
+
+    size_t GetThreadCount() const;
+
+private:
+    using JobFn = void (*)(void*, size_t);
+
+    std::vector<std::thread> threads_;
+    std::barrier<> start_barrier_;
+    std::barrier<> done_barrier_;
+    JobFn job_ = nullptr;
+    void* job_context_ = nullptr;
+    size_t job_count_ = 0;
+    std::atomic<size_t> next_index_{0};
+    bool stop_ = false;
+
+    void RunErased(size_t count, JobFn job, void* context);
+    void WorkerLoop();
+    void TakeIndices();
+};
+
+}
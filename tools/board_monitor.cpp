@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <thread>
+#include "shared_export.h"
+
+using namespace game;
+
+namespace {
+
+const char* PhaseName(uint8_t phase) {
+    switch (static_cast<GameState>(phase)) {
+        case GameState::kGameStartPhase: return "start";
+        case GameState::kGamePlayPhase: return "play";
+        case GameState::kGameLinePhase: return "lines";
+        case GameState::kGameOverPhase: return "over";
+        case GameState::kGamePause: return "pause";
+    }
+    return "?";
+}
+
+char ShapeLetter(uint8_t shape) {
+    switch (static_cast<Shape>(shape)) {
+        case Shape::kSquare: return 'O';
+        case Shape::kBar: return 'I';
+        case Shape::kPyramid: return 'T';
+        case Shape::kSShape: return 'S';
+        case Shape::kZShape: return 'Z';
+        case Shape::kLShape: return 'L';
+        case Shape::kJShape: return 'J';
+        case Shape::kNumOfShapes: return '-';
+    }
+    return '?';
+}
+
+void PrintBoard(size_t index, const SharedBoardState& state) {
+    std::printf("board %zu  tick %llu  %s  level %llu  lines %llu  points %llu\n", index,
+                static_cast<unsigned long long>(state.tick), PhaseName(state.phase),
+                static_cast<unsigned long long>(state.level), static_cast<unsigned long long>(state.cleared_lines),
+                static_cast<unsigned long long>(state.points));
+    std::string queue;
+    for (size_t i = 0; i < state.preview_count && i < state.preview.size(); ++i) {
+        queue += ShapeLetter(state.preview[i]);
+    }
+    std::printf("  next %s  hold %c\n", queue.c_str(), ShapeLetter(state.held_shape));
+    for (int row = 0; row < state.height; ++row) {
+        std::string line;
+        for (int col = 0; col < state.width; ++col) {
+            uint8_t cell = state.cells[row * state.width + col];
+            line += cell == 0 ? '.' : static_cast<char>('0' + cell);
+        }
+        std::printf("  %s\n", line.c_str());
+    }
+}
+
+}
+
+// Usage: board_monitor <segment-name> [interval-ms]
+// Prints every exported board, once or every interval-ms until interrupted.
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <segment-name> [interval-ms]\n", argv[0]);
+        return 1;
+    }
+    int interval_ms = argc > 2 ? std::atoi(argv[2]) : 0;
+
+    try {
+        SharedBoardReader reader{argv[1]};
+        SharedBoardState state;
+        do {
+            for (size_t i = 0; i < reader.GetBoardCount(); ++i) {
+                if (reader.Read(i, state)) {
+                    PrintBoard(i, state);
+                } else {
+                    std::printf("board %zu  busy\n", i);
+                }
+            }
+            if (interval_ms > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+                std::printf("\n");
+            }
+        } while (interval_ms > 0);
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "board_monitor: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "board.h"
+#include "replay.h"
+
+using namespace game;
+
+namespace {
+
+const char* MoveName(MoveType move) {
+    switch (move) {
+        case MoveType::kLeft: return "left";
+        case MoveType::kRight: return "right";
+        case MoveType::kUp: return "rotate";
+        case MoveType::kRotateCcw: return "rotate-ccw";
+        case MoveType::kRotate180: return "rotate-180";
+        case MoveType::kHold: return "hold";
+        case MoveType::kLeftWall: return "left-wall";
+        case MoveType::kRightWall: return "right-wall";
+        case MoveType::kDown: return "down";
+        case MoveType::kDrop: return "drop";
+        case MoveType::kConfirm: return "confirm";
+        case MoveType::kPause: return "pause";
+        case MoveType::kLoad: return "load";
+        case MoveType::kNone: return "none";
+    }
+    return "?";
+}
+
+// Feeds the replay into a fresh board and prints where the game ended.
+template <std::uint8_t W, std::uint8_t H>
+int Simulate(ReplayReader& reader) {
+    Board<W, H> board;
+    board.SetTimingModel(reader.GetHeader().timing);
+    board.Reset(reader.GetHeader().seed, reader.GetHeader().start_level);
+    const auto base = std::chrono::steady_clock::time_point{};
+    reader.Seek(0);
+    ReplayEvent event;
+    uint64_t index = 0;
+    // Tick indices as the game counted them, NES timing counts frames by them.
+    FrameTime tick{base, 0};
+    while (reader.Next(event)) {
+        switch (event.type) {
+            case ReplayEvent::Type::kUpdate: {
+                auto previous = board.GetActualGamePhase();
+                auto now = base + std::chrono::nanoseconds(event.time_ns);
+                if (now != tick.now) {
+                    tick = FrameTime{now, tick.index + 1};
+                }
+                auto phase = board.UpdateGame(event.move, tick);
+                if (phase == GameState::kGameOverPhase && previous != GameState::kGameOverPhase) {
+                    std::printf("topped out at %.3f s: level %zu  lines %zu  points %zu\n", event.time_ns / 1e9,
+                                board.GetLevel(), board.GetClearedLineCount(), board.GetPoints());
+                }
+                break;
+            }
+            case ReplayEvent::Type::kGarbage:
+                board.QueueGarbage(event.lines);
+                break;
+            case ReplayEvent::Type::kStartGame:
+                board.StartGame();
+                break;
+            case ReplayEvent::Type::kPlayGame:
+                board.PlayGame();
+                break;
+            case ReplayEvent::Type::kGameOver:
+                board.GameOver();
+                break;
+        }
+        ++index;
+    }
+    if (index != reader.GetEventCount()) {
+        std::fprintf(stderr, "replay is corrupt after event %llu\n", static_cast<unsigned long long>(index));
+        return 1;
+    }
+    std::printf("end of replay: %s  level %zu  lines %zu  points %zu\n",
+                GetGameStateName(board.GetActualGamePhase()), board.GetLevel(), board.GetClearedLineCount(),
+                board.GetPoints());
+    return 0;
+}
+
+}
+
+// Usage: replay_check <file.replay> [--dump <event>]
+// Prints the replay's header and size, replays it on a board, and with --dump
+// lists the events from the checkpoint before <event>.
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <file.replay> [--dump <event>]\n", argv[0]);
+        return 1;
+    }
+    std::ifstream file(argv[1], std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    std::vector<uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    ReplayReader reader;
+    if (!reader.Open(data)) {
+        std::fprintf(stderr, "%s is not a replay\n", argv[1]);
+        return 1;
+    }
+
+    const auto& header = reader.GetHeader();
+    const auto events = reader.GetEventCount();
+    std::printf("board %ux%u  seed %u  start level %u  %s timing\n", header.width, header.height, header.seed,
+                header.start_level, header.timing == TimingModel::kNesFrames ? "NES frame" : "real-time");
+    std::printf("%llu events in %zu bytes (%.2f bits per event), %zu checkpoints\n",
+                static_cast<unsigned long long>(events), data.size(),
+                events > 0 ? 8.0 * data.size() / events : 0.0, reader.GetCheckpoints().size());
+
+    if (argc > 3 && std::string(argv[2]) == "--dump") {
+        uint64_t target = std::strtoull(argv[3], nullptr, 10);
+        uint64_t index = reader.Seek(target);
+        ReplayEvent event;
+        for (int shown = 0; shown < 20 && reader.Next(event); ++index) {
+            if (index < target) {
+                continue;
+            }
+            ++shown;
+            if (event.type == ReplayEvent::Type::kUpdate) {
+                std::printf("%8llu  %10.3f s  %s\n", static_cast<unsigned long long>(index), event.time_ns / 1e9,
+                            MoveName(event.move));
+            } else if (event.type == ReplayEvent::Type::kGarbage) {
+                std::printf("%8llu  garbage %u\n", static_cast<unsigned long long>(index), event.lines);
+            } else {
+                std::printf("%8llu  phase change\n", static_cast<unsigned long long>(index));
+            }
+        }
+    }
+
+    if (header.width == 10 && header.height == 22) {
+        return Simulate<10, 22>(reader);
+    }
+    if (header.width == 16 && header.height == 22) {
+        return Simulate<16, 22>(reader);
+    }
+    if (header.width == 10 && header.height == 40) {
+        return Simulate<10, 40>(reader);
+    }
+    std::fprintf(stderr, "no board of size %ux%u to replay on\n", header.width, header.height);
+    return 1;
+}